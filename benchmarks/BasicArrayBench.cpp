@@ -0,0 +1,130 @@
+/*
+	Filling, reading and clearing the Array from BasicArray, one element at a time.
+
+	The file backed ones use a temporary array file: opening it mapped vs reading it all into a heap Array, and a full
+	sequential or random read through a freshly opened mapping with each access hint (so the page faults are counted).
+*/
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../data_structures/Array/Array/ArrayBasic/Array.h"
+
+static void BM_ArrayInsert(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	Array array{ size };
+	for (auto _ : state) {
+		for (int i{ 0 }; i < size; ++i) array.insert(i, i);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_ArrayInsert)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+static void BM_ArrayGetValue(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	Array array{ size };
+	for (int i{ 0 }; i < size; ++i) array.insert(i, i);
+	for (auto _ : state) {
+		long long sum{ 0 };
+		for (int i{ 0 }; i < size; ++i) sum += array.getValue(i);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_ArrayGetValue)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+static void BM_ArrayRemove(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	Array array{ size };
+	for (auto _ : state) {
+		for (int i{ 0 }; i < size; ++i) array.remove(i);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_ArrayRemove)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+// Array file of `size` elements (0, 1, 2...) in the temp directory, created once per size and deleted at exit
+static std::string arrayFile(int size) {
+	struct TempFiles {
+		std::vector<std::string> names;
+		~TempFiles() {
+			for (const std::string& name : names) std::remove(name.c_str());
+		}
+	};
+	static TempFiles files;
+
+	std::string name = (std::filesystem::temp_directory_path() / ("BasicArrayBench_" + std::to_string(size) + ".bin")).string();
+	for (const std::string& existing : files.names) {
+		if (existing == name) return name;
+	}
+	std::remove(name.c_str());
+	Array array = Array::openFile(name, size);
+	for (int i{ 0 }; i < size; ++i) array.insert(i, i);
+	array.sync();
+	files.names.push_back(name);
+	return name;
+}
+
+static void BM_ArrayOpenFile(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	const std::string name = arrayFile(size);
+	for (auto _ : state) {
+		Array array = Array::openFile(name);
+		benchmark::DoNotOptimize(array.getValue(size - 1));
+	}
+	state.SetBytesProcessed(state.iterations() * size * static_cast<int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_ArrayOpenFile)->RangeMultiplier(16)->Range(1 << 16, 1 << 26)->Unit(benchmark::kMicrosecond);
+
+// What opening looked like before: read every element into a heap Array
+static void BM_ArrayLoadFile(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	const std::string name = arrayFile(size);
+	for (auto _ : state) {
+		std::ifstream file{ name, std::ios::binary };
+		file.seekg(16); // Header
+		Array array{ size };
+		std::vector<int> buffer(1 << 16);
+		for (int i{ 0 }; i < size;) {
+			int count = std::min(static_cast<int>(buffer.size()), size - i);
+			file.read(reinterpret_cast<char*>(buffer.data()), count * sizeof(int));
+			for (int j{ 0 }; j < count; ++j) array.insert(i++, buffer[j]);
+		}
+		benchmark::DoNotOptimize(array.getValue(size - 1));
+	}
+	state.SetBytesProcessed(state.iterations() * size * static_cast<int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_ArrayLoadFile)->RangeMultiplier(16)->Range(1 << 16, 1 << 26)->Unit(benchmark::kMicrosecond);
+
+// Arg 0: the size, arg 1: 0 sequential read, 1 random read. Arg 2: the hint (Array::Access)
+static void BM_ArrayFileRead(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	const bool random = state.range(1) != 0;
+	const Array::Access access = static_cast<Array::Access>(state.range(2));
+	const std::string name = arrayFile(size);
+
+	std::vector<int> order(size);
+	for (int i{ 0 }; i < size; ++i) order[i] = i;
+	if (random) std::shuffle(order.begin(), order.end(), std::mt19937{ 42 });
+
+	for (auto _ : state) {
+		Array array = Array::openFile(name);
+		array.adviseAccess(access);
+		long long sum{ 0 };
+		for (int idx : order) sum += array.getValue(idx);
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * size);
+	state.SetLabel(std::string{ random ? "random" : "sequential" } + (access == Array::Access::SEQUENTIAL ? ", SEQUENTIAL hint" : access == Array::Access::RANDOM ? ", RANDOM hint" : ", no hint"));
+}
+BENCHMARK(BM_ArrayFileRead)
+	->ArgsProduct({ { 1 << 24 }, { 0, 1 }, { static_cast<int>(Array::Access::NORMAL), static_cast<int>(Array::Access::SEQUENTIAL), static_cast<int>(Array::Access::RANDOM) } })
+	->Unit(benchmark::kMillisecond);
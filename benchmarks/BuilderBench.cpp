@@ -0,0 +1,27 @@
+/*
+	Builder: a builder per controller, customized and built. This version's build() hands out the builder's own scheme,
+	so deleting the builder is part of every iteration.
+*/
+#include <benchmark/benchmark.h>
+
+#include "../design_patterns/Creational/Builder/ControllerSchemeBuilder.h"
+
+static void BM_BuildDualsense(benchmark::State& state) {
+	for (auto _ : state) {
+		DualsenseControllerSchemeBuilder* builder = new DualsenseControllerSchemeBuilder();
+		DualsenseControllerScheme* scheme = builder->setTrim("purple")->setTriggers("purple")->build();
+		benchmark::DoNotOptimize(scheme);
+		delete builder;
+	}
+}
+BENCHMARK(BM_BuildDualsense);
+
+static void BM_BuildXbox(benchmark::State& state) {
+	for (auto _ : state) {
+		XboxControllerSchemeBuilder* builder = new XboxControllerSchemeBuilder();
+		XboxControllerScheme* scheme = builder->setBatteryCover("green")->setFrontShell("green")->build();
+		benchmark::DoNotOptimize(scheme);
+		delete builder;
+	}
+}
+BENCHMARK(BM_BuildXbox);
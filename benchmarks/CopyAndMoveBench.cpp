@@ -0,0 +1,81 @@
+/*
+	Copying and moving the Vector from CopyAndMove. Copies are swept from 1 KB to 1 GB (they go through LargeCopy, which
+	changes strategy with the size), moves shouldn't depend on the size at all. BM_LargeCopy times every strategy on the
+	big sizes so the automatic thresholds can be checked against them.
+*/
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../cpp_concepts/CopyAndMove/Vector.h"
+
+// Vector sizes in ints for 1 KB, 16 KB, ... 1 GB
+static void byteSweep(benchmark::internal::Benchmark* benchmark) {
+	for (int64_t bytes : { 1 << 10, 1 << 14, 1 << 18, 1 << 22, 1 << 26, 1 << 28, 1 << 30 })
+		benchmark->Arg(bytes / static_cast<int64_t>(sizeof(int)));
+}
+
+static Vector makeFilledVector(int size) {
+	Vector vector{ size };
+	for (int i{ 0 }; i < size; ++i) vector[i] = i;
+	return vector;
+}
+
+static void BM_VectorCopyConstruct(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	Vector source = makeFilledVector(size);
+	for (auto _ : state) {
+		Vector copy{ source };
+		benchmark::DoNotOptimize(&copy[0]);
+	}
+	state.SetBytesProcessed(state.iterations() * size * static_cast<int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_VectorCopyConstruct)->ArgName("ints")->Apply(byteSweep)->UseRealTime();
+
+static void BM_VectorCopyAssign(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	Vector source = makeFilledVector(size);
+	Vector target{ size };
+	for (auto _ : state) {
+		target = source;
+		benchmark::DoNotOptimize(&target[0]);
+	}
+	state.SetBytesProcessed(state.iterations() * size * static_cast<int64_t>(sizeof(int)));
+}
+BENCHMARK(BM_VectorCopyAssign)->ArgName("ints")->Apply(byteSweep)->UseRealTime();
+
+// Moves the data out and back in, so every iteration starts from the same state
+static void BM_VectorMoveConstruct(benchmark::State& state) {
+	Vector source = makeFilledVector(static_cast<int>(state.range(0)));
+	for (auto _ : state) {
+		Vector moved{ std::move(source) };
+		benchmark::DoNotOptimize(&moved[0]);
+		source = std::move(moved);
+	}
+}
+BENCHMARK(BM_VectorMoveConstruct)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_VectorMoveAssign(benchmark::State& state) {
+	Vector source = makeFilledVector(static_cast<int>(state.range(0)));
+	Vector target{ 1 };
+	for (auto _ : state) {
+		target = std::move(source);
+		benchmark::DoNotOptimize(&target[0]);
+		source = std::move(target);
+	}
+}
+BENCHMARK(BM_VectorMoveAssign)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+// strategy: 1 memcpy, 2 streaming stores, 3 streaming stores on every hardware thread
+static void BM_LargeCopy(benchmark::State& state) {
+	const size_t bytes = static_cast<size_t>(state.range(0));
+	const auto strategy = static_cast<LargeCopy::Strategy>(state.range(1));
+	std::vector<char> source(bytes, 1), destination(bytes, 0);
+	for (auto _ : state) {
+		LargeCopy::copy(destination.data(), source.data(), bytes, strategy);
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_LargeCopy)->ArgNames({ "bytes", "strategy" })->ArgsProduct({ { 1 << 20, 1 << 26, 1 << 28, 1 << 30 }, { 1, 2, 3 } })->UseRealTime();
@@ -0,0 +1,79 @@
+/*
+	EnemyShipFactory against EnemyShipVariantFactory: making ships, and adding up the damage of a fleet.
+
+	What the two fleets measure is storage, not virtual dispatch: EnemyShip::getDamage isn't virtual, so the pointer fleet
+	follows each pointer to a heap ship (vtable pointer + std::string name + damage, 48 bytes) and loads the damage from it.
+	The variant fleet stores each ship inline (its damage and the type index, 8 bytes), and std::visit switches on the
+	index to run the ship type's getDamage, which loads the damage from the ship the same way. The pointer fleet is also
+	run shuffled, which is what a fleet looks like after ships have been spawned and destroyed for a while (the heap hands
+	out whatever is free).
+*/
+#include <algorithm>
+#include <random>
+#include <variant>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../design_patterns/FactoryMethod/EnemyShip.h"
+#include "../design_patterns/FactoryMethod/EnemyShipVariant.h"
+
+static void BM_MakeEnemyShip(benchmark::State& state) {
+	EnemyShipFactory factory;
+	const char types[]{ 'U', 'R' };
+	int i{ 0 };
+	for (auto _ : state) {
+		EnemyShip* ship = factory.makeEnemyShip(types[i++ & 1]);
+		benchmark::DoNotOptimize(ship);
+		delete ship;
+	}
+}
+BENCHMARK(BM_MakeEnemyShip);
+
+static void BM_MakeEnemyShipVariant(benchmark::State& state) {
+	EnemyShipVariantFactory factory;
+	const char types[]{ 'U', 'R' };
+	int i{ 0 };
+	for (auto _ : state) {
+		EnemyShipVariant ship = factory.makeEnemyShip(types[i++ & 1]);
+		benchmark::DoNotOptimize(ship);
+	}
+}
+BENCHMARK(BM_MakeEnemyShipVariant);
+
+static char shipType(int64_t i) { return i % 3 == 0 ? 'R' : 'U'; }
+
+static void BM_FleetTotalDamage(benchmark::State& state) {
+	EnemyShipFactory factory;
+	std::vector<EnemyShip*> fleet;
+	for (int64_t i{ 0 }; i < state.range(0); ++i)
+		fleet.push_back(factory.makeEnemyShip(shipType(i)));
+	if (state.range(1)) std::shuffle(fleet.begin(), fleet.end(), std::mt19937{ 42 });
+
+	for (auto _ : state) {
+		float damage{ 0 };
+		for (const EnemyShip* ship : fleet) damage += ship->getDamage();
+		benchmark::DoNotOptimize(damage);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+
+	for (EnemyShip* ship : fleet) delete ship;
+}
+BENCHMARK(BM_FleetTotalDamage)->ArgNames({ "ships", "shuffled" })->ArgsProduct({ { 1 << 10, 1 << 15, 1 << 20 }, { 0, 1 } });
+
+static void BM_VariantFleetTotalDamage(benchmark::State& state) {
+	EnemyShipVariantFactory factory;
+	std::vector<EnemyShipVariant> fleet;
+	fleet.reserve(state.range(0));
+	for (int64_t i{ 0 }; i < state.range(0); ++i)
+		fleet.push_back(factory.makeEnemyShip(shipType(i)));
+
+	for (auto _ : state) {
+		float damage{ 0 };
+		for (const EnemyShipVariant& ship : fleet)
+			damage += std::visit([](const auto& concreteShip) { return concreteShip.getDamage(); }, ship);
+		benchmark::DoNotOptimize(damage);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VariantFleetTotalDamage)->ArgName("ships")->Arg(1 << 10)->Arg(1 << 15)->Arg(1 << 20);
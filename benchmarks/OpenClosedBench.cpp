@@ -0,0 +1,90 @@
+/*
+	BetterProductFilter over random products, with one specification and with two joined by &&, and the same && filter
+	streaming a 1M row CSV catalog through ProductCatalog.
+*/
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../design_patterns/SOLID_2_OCP/ProductCatalog.h"
+#include "../design_patterns/SOLID_2_OCP/ProductFilter.h"
+
+static std::vector<Product> makeProducts(int64_t count) {
+	std::mt19937 rng{ 42 };
+	std::uniform_int_distribution<int> pick{ 0, 2 };
+	std::vector<Product> products;
+	products.reserve(count);
+	for (int64_t i{ 0 }; i < count; ++i)
+		products.emplace_back("Product " + std::to_string(i), static_cast<Color>(pick(rng)), static_cast<Size>(pick(rng)));
+	return products;
+}
+
+static std::vector<Product*> pointersTo(std::vector<Product>& products) {
+	std::vector<Product*> pointers;
+	for (Product& product : products) pointers.push_back(&product);
+	return pointers;
+}
+
+static void BM_FilterByColor(benchmark::State& state) {
+	std::vector<Product> products = makeProducts(state.range(0));
+	std::vector<Product*> items = pointersTo(products);
+	BetterProductFilter filter;
+	ColorSpecification red{ Color::Red };
+	for (auto _ : state) {
+		std::vector<Product*> filtered = filter.filter(items, red);
+		benchmark::DoNotOptimize(filtered.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FilterByColor)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+static void BM_FilterByColorAndSize(benchmark::State& state) {
+	std::vector<Product> products = makeProducts(state.range(0));
+	std::vector<Product*> items = pointersTo(products);
+	BetterProductFilter filter;
+	ColorSpecification red{ Color::Red };
+	SizeSpecification small{ Size::Small };
+	auto redAndSmall = red && small;
+	for (auto _ : state) {
+		std::vector<Product*> filtered = filter.filter(items, redAndSmall);
+		benchmark::DoNotOptimize(filtered.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FilterByColorAndSize)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+static void BM_CatalogFilter(benchmark::State& state) {
+	const std::string filename{ "catalog_benchmark.csv" };
+	const int rows{ 1000000 };
+	{
+		std::ofstream ofs{ filename, std::ios::binary };
+		const char* colorNames[]{ "Red", "Green", "Blue" };
+		const char* sizeNames[]{ "Small", "Medium", "Large" };
+		std::mt19937 rng{ 42 };
+		ofs << "name,color,size\n";
+		for (int i{ 0 }; i < rows; ++i)
+			ofs << "Controller " << i << ',' << colorNames[rng() % 3] << ',' << sizeNames[rng() % 3] << '\n';
+	}
+
+	ProductCatalog catalog{ filename };
+	ColorSpecification red{ Color::Red };
+	SizeSpecification small{ Size::Small };
+	auto redAndSmall = red && small;
+	for (auto _ : state) {
+		CatalogStats stats = catalog.filter(redAndSmall, static_cast<int>(state.range(0)));
+		benchmark::DoNotOptimize(stats.matches);
+	}
+	state.SetItemsProcessed(state.iterations() * rows);
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(catalog.sizeInBytes()));
+	std::remove(filename.c_str());
+}
+BENCHMARK(BM_CatalogFilter)->ArgName("threads")->Apply([](benchmark::internal::Benchmark* benchmark) {
+	benchmark->Arg(1);
+	int threads = static_cast<int>(std::thread::hardware_concurrency());
+	if (threads > 1) benchmark->Arg(threads);
+})->UseRealTime();
@@ -0,0 +1,159 @@
+/*
+	Pong game logic without a window: one PongGameHeadless step (overlap and swept collisions), PongBatch stepping many
+	matches at once, a single swept ball vs paddle test, the multi-ball world with both broadphases, and what a
+	PongSimulationThread tick costs on top of the step (publishing a state, reading one back, passing an input).
+*/
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../raylib_pong/Pong/MultiBallWorld.h"
+#include "../raylib_pong/Pong/PongBatch.h"
+#include "../raylib_pong/Pong/PongGameHeadless.h"
+#include "../raylib_pong/Pong/PongSimulationThread.h"
+#include "../raylib_pong/Pong/SweptCollision.h"
+
+static const PlayableRectangle gameArea{ 0, 0, 800, 600 };
+static const float timeStep{ 1.0f / 60.0f };
+
+static void BM_HeadlessUpdate(benchmark::State& state) {
+	Ball ball{ 5, -500, 170 };
+	Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
+	Paddle rightPaddle{ 10, 100, Paddle::RIGHT, 500 };
+	PongGameHeadless game{ gameArea, ball, leftPaddle, rightPaddle, timeStep };
+	game.initialize();
+	game.continuousCollisions = state.range(0) != 0;
+
+	int step{ 0 };
+	for (auto _ : state) {
+		// Paddles go up and down every second so the ball doesn't settle into a loop against a wall
+		game.leftInput = ((step / 60) & 1) ? 1 : -1;
+		game.rightInput = -game.leftInput;
+		game.update();
+		++step;
+		benchmark::DoNotOptimize(ball.position);
+	}
+}
+BENCHMARK(BM_HeadlessUpdate)->ArgName("swept")->Arg(0)->Arg(1);
+
+static void BM_BatchStep(benchmark::State& state) {
+	const int matches = static_cast<int>(state.range(0));
+	const int threads = static_cast<int>(state.range(1));
+	PongBatch batch{ matches, gameArea, Ball{ 5, -500 }, Paddle{ 10, 100, Paddle::LEFT, 500 } };
+
+	std::mt19937 rng{ 2024 };
+	std::uniform_real_distribution<float> speed{ -300.0f, 300.0f };
+	std::uniform_int_distribution<int> input{ -1, 1 };
+	for (int i{ 0 }; i < matches; ++i) {
+		batch.setBallSpeed(i, -500.0f, speed(rng));
+		batch.setInputs(i, input(rng), input(rng));
+	}
+
+	for (auto _ : state) {
+		batch.step(timeStep, 1, threads);
+		benchmark::DoNotOptimize(batch.ballX.data());
+	}
+	state.SetItemsProcessed(state.iterations() * matches);
+}
+BENCHMARK(BM_BatchStep)->ArgNames({ "matches", "threads" })->UseRealTime()->Apply([](benchmark::internal::Benchmark* benchmark) {
+	for (int matches : { 1 << 10, 1 << 14, 1 << 17 }) benchmark->Args({ matches, 1 });
+	int threads = static_cast<int>(std::thread::hardware_concurrency());
+	if (threads > 1) benchmark->Args({ 1 << 17, threads });
+});
+
+static void BM_SweepBallPaddle(benchmark::State& state) {
+	Paddle paddle{ 10, 100, Paddle::LEFT, 500 };
+	paddle.positionInPlayableArea(gameArea);
+
+	// Random motions from the right of the paddle, about half of them hit
+	std::mt19937 rng{ 7 };
+	std::uniform_real_distribution<float> offsetY{ -120.0f, 120.0f };
+	std::uniform_real_distribution<float> motionY{ -40.0f, 40.0f };
+	std::vector<Vector2> centers, motions;
+	for (int i{ 0 }; i < 1024; ++i) {
+		centers.push_back({ paddle.position.x + 30.0f, paddle.position.y + offsetY(rng) });
+		motions.push_back({ -60.0f, motionY(rng) });
+	}
+
+	size_t i{ 0 };
+	for (auto _ : state) {
+		SweepHit hit;
+		bool hits = sweepBallPaddle(centers[i], 5.0f, motions[i], paddle, hit);
+		benchmark::DoNotOptimize(hits);
+		benchmark::DoNotOptimize(hit);
+		i = (i + 1) & 1023;
+	}
+}
+BENCHMARK(BM_SweepBallPaddle);
+
+// Same ball density for every count, the area grows with it
+static void BM_MultiBallStep(benchmark::State& state) {
+	const int count = static_cast<int>(state.range(0));
+	const int side = static_cast<int>(std::sqrt(count * 400.0f));
+	const PlayableRectangle area{ 0, 0, side, side };
+	Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
+	Paddle rightPaddle{ 10, 100, Paddle::RIGHT, 500 };
+	leftPaddle.positionInPlayableArea(area);
+	rightPaddle.positionInPlayableArea(area);
+
+	MultiBallWorld world{ area, leftPaddle, rightPaddle, 3.0f };
+	world.spawnRandomBalls(count, 3.0f, 100.0f, 300.0f, 7);
+	world.broadphase = state.range(1) ? MultiBallWorld::Broadphase::PAIRWISE : MultiBallWorld::Broadphase::GRID;
+
+	for (auto _ : state) {
+		world.step(1.0f / 120.0f);
+		benchmark::DoNotOptimize(world.balls.data());
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_MultiBallStep)->ArgNames({ "balls", "pairwise" })->Apply([](benchmark::internal::Benchmark* benchmark) {
+	for (int balls : { 1000, 4000, 16000 }) {
+		benchmark->Args({ balls, 0 });
+		benchmark->Args({ balls, 1 });
+	}
+	benchmark->Args({ 64000, 0 });
+});
+
+// tick() on the calling thread (no thread started) vs the plain step it wraps
+static void BM_SimulationTick(benchmark::State& state) {
+	Ball ball{ 5, -500, 170 };
+	Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
+	Paddle rightPaddle{ 10, 100, Paddle::RIGHT, 500 };
+	PongGameHeadless game{ gameArea, ball, leftPaddle, rightPaddle, 1.0f / 1000.0f };
+	game.initialize();
+	PongSimulationThread simulation{ game };
+
+	int step{ 0 };
+	for (auto _ : state) {
+		int8_t input = ((step++ / 1000) & 1) ? 1 : -1;
+		simulation.sendInput({ input, static_cast<int8_t>(-input) });
+		simulation.tick();
+		benchmark::DoNotOptimize(simulation.stateAt(simulation.secondsSinceStart()));
+	}
+}
+BENCHMARK(BM_SimulationTick);
+
+static void BM_TripleBufferPublishRead(benchmark::State& state) {
+	TripleBuffer<PongTickState> buffer;
+	uint64_t step{ 0 };
+	for (auto _ : state) {
+		buffer.back().current.step = ++step;
+		buffer.publish();
+		benchmark::DoNotOptimize(buffer.read().current.step);
+	}
+}
+BENCHMARK(BM_TripleBufferPublishRead);
+
+static void BM_SpscQueuePushPop(benchmark::State& state) {
+	SpscQueue<PongInput, 64> queue;
+	PongInput input;
+	for (auto _ : state) {
+		queue.tryPush({ 1, -1 });
+		queue.tryPop(input);
+		benchmark::DoNotOptimize(input);
+	}
+}
+BENCHMARK(BM_SpscQueuePushPop);
@@ -0,0 +1,36 @@
+/*
+	Prototype: cloning the default schemes, and building through a builder that's reused (every build() is a clone plus
+	a reset to the default scheme, another clone).
+*/
+#include <benchmark/benchmark.h>
+
+#include "../design_patterns/Creational/Prototype/ControllerSchemePrototype.h"
+
+static void BM_CloneDefaultDualsense(benchmark::State& state) {
+	for (auto _ : state) {
+		DualsenseControllerScheme* scheme = DualsenseControllerScheme::defaultScheme.clone();
+		benchmark::DoNotOptimize(scheme);
+		delete scheme;
+	}
+}
+BENCHMARK(BM_CloneDefaultDualsense);
+
+static void BM_BuildDualsenseReusingBuilder(benchmark::State& state) {
+	DualsenseControllerSchemeBuilder builder;
+	for (auto _ : state) {
+		DualsenseControllerScheme* scheme = builder.setTrim("purple")->setTriggers("purple")->build();
+		benchmark::DoNotOptimize(scheme);
+		delete scheme;
+	}
+}
+BENCHMARK(BM_BuildDualsenseReusingBuilder);
+
+static void BM_BuildXboxReusingBuilder(benchmark::State& state) {
+	XboxControllerSchemeBuilder builder;
+	for (auto _ : state) {
+		XboxControllerScheme* scheme = builder.setBatteryCover("green")->build();
+		benchmark::DoNotOptimize(scheme);
+		delete scheme;
+	}
+}
+BENCHMARK(BM_BuildXboxReusingBuilder);
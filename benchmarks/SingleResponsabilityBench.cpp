@@ -0,0 +1,126 @@
+/*
+	Journal: adding entries (which also indexes them), saving it with JournalSaver, and searching with the index vs
+	scanning every entry.
+*/
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../design_patterns/SOLID_1_SRP/Journal.h"
+
+static void BM_JournalAdd(benchmark::State& state) {
+	const std::string entry{ "I got the GoW Ragnarok ps5 controller today" };
+	for (auto _ : state) {
+		Journal journal{ "Benchmark" };
+		for (int64_t i{ 0 }; i < state.range(0); ++i) journal.add(entry);
+		benchmark::DoNotOptimize(journal.entries.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_JournalAdd)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+static void BM_JournalSave(benchmark::State& state) {
+	Journal journal{ "Benchmark" };
+	for (int64_t i{ 0 }; i < state.range(0); ++i) journal.add("I got the GoW Ragnarok ps5 controller today");
+
+	const std::string filename{ "journal_benchmark.txt" };
+	for (auto _ : state)
+		JournalSaver::save(journal, filename);
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	std::remove(filename.c_str());
+	std::remove(JournalSaver::indexFilename(filename).c_str());
+}
+BENCHMARK(BM_JournalSave)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+// Journal of `size` entries of 8 words each, picked from a 50k word vocabulary with Zipf frequencies (word0 the most
+// common, like real text). Built once per size
+static const Journal& searchJournal(int size) {
+	static std::map<int, std::unique_ptr<Journal>> journals;
+	std::unique_ptr<Journal>& journal = journals[size];
+	if (journal) return *journal;
+
+	constexpr int vocabulary{ 50000 };
+	std::vector<double> cumulative(vocabulary);
+	double total{ 0 };
+	for (int rank{ 0 }; rank < vocabulary; ++rank) cumulative[rank] = (total += 1.0 / (rank + 1));
+
+	std::mt19937 rng{ 42 };
+	std::uniform_real_distribution<double> pick{ 0, total };
+	journal = std::make_unique<Journal>("Search benchmark");
+	std::string entry;
+	for (int i{ 0 }; i < size; ++i) {
+		entry.clear();
+		for (int w{ 0 }; w < 8; ++w) {
+			int rank = static_cast<int>(std::lower_bound(cumulative.begin(), cumulative.end(), pick(rng)) - cumulative.begin());
+			entry += "word" + std::to_string(std::min(rank, vocabulary - 1)) + ' ';
+		}
+		journal->add(entry);
+	}
+	return *journal;
+}
+
+// Queries: 0 two common words (all), 1 a rare and a common word (all), 2 two mid frequency words (any)
+static const char* searchQueries[]{ "word0 word1", "word4000 word0", "word50 word60" };
+static const JournalIndex::Match searchMatches[]{ JournalIndex::Match::ALL, JournalIndex::Match::ALL, JournalIndex::Match::ANY };
+
+static void BM_JournalSearchIndex(benchmark::State& state) {
+	const Journal& journal = searchJournal(static_cast<int>(state.range(0)));
+	const int query = static_cast<int>(state.range(1));
+	size_t found{ 0 };
+	for (auto _ : state) {
+		std::vector<uint32_t> result = journal.search(searchQueries[query], searchMatches[query]);
+		found = result.size();
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.counters["found"] = static_cast<double>(found);
+	state.counters["index_MB"] = journal.index.getPostingsBytes() / 1e6;
+	state.SetLabel(searchQueries[query]);
+}
+BENCHMARK(BM_JournalSearchIndex)->ArgsProduct({ { 1 << 16, 1 << 21 }, { 0, 1, 2 } })->Unit(benchmark::kMicrosecond);
+
+// Without the index: a substring search of every entry (which also matches "word01" for "word0")
+static void BM_JournalSearchScan(benchmark::State& state) {
+	const Journal& journal = searchJournal(static_cast<int>(state.range(0)));
+	const int query = static_cast<int>(state.range(1));
+	std::vector<std::string> words;
+	JournalIndex::forEachToken(searchQueries[query], [&](const std::string& word) { words.push_back(word); });
+	const bool all = searchMatches[query] == JournalIndex::Match::ALL;
+
+	size_t found{ 0 };
+	for (auto _ : state) {
+		std::vector<uint32_t> result;
+		for (size_t i{ 0 }; i < journal.entries.size(); ++i) {
+			int hits{ 0 };
+			for (const std::string& word : words) hits += journal.entries[i].find(word) != std::string::npos;
+			if (all ? hits == static_cast<int>(words.size()) : hits > 0) result.push_back(static_cast<uint32_t>(i));
+		}
+		found = result.size();
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.counters["found"] = static_cast<double>(found);
+	state.SetLabel(searchQueries[query]);
+}
+BENCHMARK(BM_JournalSearchScan)->ArgsProduct({ { 1 << 16, 1 << 21 }, { 0, 1, 2 } })->Unit(benchmark::kMillisecond);
+
+static void BM_JournalIndexSaveLoad(benchmark::State& state) {
+	const Journal& journal = searchJournal(static_cast<int>(state.range(0)));
+	const std::string filename{ "journal_index_benchmark.index" };
+	for (auto _ : state) {
+		{
+			std::ofstream out{ filename, std::ios::binary };
+			journal.index.write(out);
+		}
+		JournalIndex index;
+		std::ifstream in{ filename, std::ios::binary };
+		benchmark::DoNotOptimize(index.read(in));
+	}
+	std::remove(filename.c_str());
+}
+BENCHMARK(BM_JournalIndexSaveLoad)->Arg(1 << 21)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,61 @@
+/*
+	Snake game logic: a tick with short and long snakes (they follow the Hamiltonian cycle so they never die), food
+	placement on a nearly full board, and the autoplayer playing whole games.
+*/
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "../raylib_snake/SnakeAutoplayer.h"
+#include "../raylib_snake/SnakeCore.h"
+
+static void BM_SnakeTick(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	SnakeGame game{ size, size, 42 };
+
+	// Untimed: grow the snake to cover the requested share of the board
+	size_t targetLength = static_cast<size_t>(size) * size * state.range(1) / 100;
+	game.grow(static_cast<int>(targetLength - game.length()));
+	while (game.length() < targetLength) {
+		game.setDirection(hamiltonianCycleDirection(game.head(), size, size));
+		game.tick();
+	}
+
+	for (auto _ : state) {
+		game.setDirection(hamiltonianCycleDirection(game.head(), size, size));
+		if (game.tick() != SnakeGame::State::PLAYING) {
+			state.PauseTiming();
+			game.reset();
+			state.ResumeTiming();
+		}
+	}
+}
+BENCHMARK(BM_SnakeTick)->ArgNames({ "size", "fill%" })->Args({ 64, 1 })->Args({ 64, 50 })->Args({ 1024, 1 })->Args({ 1024, 90 });
+
+static void BM_SelectFree(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	OccupancyGrid grid{ size, size };
+	std::mt19937_64 rng{ 7 };
+	std::uniform_int_distribution<int> coordinate{ 0, size - 1 };
+	while (grid.occupiedCount() < grid.cellCount() * 99 / 100) {
+		Cell cell{ coordinate(rng), coordinate(rng) };
+		if (!grid.isOccupied(cell)) grid.occupy(cell);
+	}
+
+	std::uniform_int_distribution<size_t> pick{ 0, grid.freeCount() - 1 };
+	for (auto _ : state)
+		benchmark::DoNotOptimize(grid.selectFree(pick(rng)));
+}
+BENCHMARK(BM_SelectFree)->Arg(64)->Arg(1024);
+
+// Plan + tick, new game every time one ends
+static void BM_AutoplayerMove(benchmark::State& state) {
+	const int size = static_cast<int>(state.range(0));
+	SnakeGame game{ size, size, 1 };
+	SnakeAutoplayer autoplayer{ game };
+	for (auto _ : state) {
+		game.setDirection(autoplayer.nextMove());
+		if (game.tick() != SnakeGame::State::PLAYING) game.reset();
+	}
+}
+BENCHMARK(BM_AutoplayerMove)->Arg(16)->Arg(32);
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+Compares two Google Benchmark JSON runs and flags the benchmarks that got slower by more than a threshold.
+
+Each side can be a JSON file or a directory of them (what the run_benchmarks target writes to benchmark_results/).
+With --benchmark_repetitions the median aggregate is compared, otherwise the single run. Benchmarks that only show
+up on one side are listed but don't count as regressions.
+
+Usage: compare_benchmarks.py <baseline> <contender> [--threshold 0.05] [--metric real_time|cpu_time]
+Exit code is 1 if anything regressed, so it can gate CI.
+"""
+import argparse
+import json
+import sys
+from pathlib import Path
+
+
+def load_results(path, metric):
+	path = Path(path)
+	files = sorted(path.glob("*.json")) if path.is_dir() else [path]
+	if not files:
+		sys.exit(f"No JSON results in {path}")
+
+	results = {}
+	for file in files:
+		with open(file) as f:
+			data = json.load(f)
+		runs = {}
+		medians = {}
+		for benchmark in data.get("benchmarks", []):
+			if benchmark.get("error_occurred"):
+				continue
+			# Times are in each benchmark's own unit, convert to ns so files with different units still compare
+			scale = {"ns": 1, "us": 1e3, "ms": 1e6, "s": 1e9}[benchmark.get("time_unit", "ns")]
+			name = benchmark.get("run_name", benchmark["name"])
+			if benchmark.get("run_type") == "aggregate":
+				if benchmark.get("aggregate_name") == "median":
+					medians[name] = benchmark[metric] * scale
+			else:
+				runs.setdefault(name, []).append(benchmark[metric] * scale)
+		# --benchmark_report_aggregates_only leaves only the aggregates, so a benchmark can have a median and no runs
+		for name in list(runs) + [name for name in medians if name not in runs]:
+			key = f"{file.stem}/{name}" if path.is_dir() else name
+			if name in medians:
+				results[key] = medians[name]
+			else:
+				times = sorted(runs[name])
+				results[key] = times[len(times) // 2]
+	return results
+
+
+def format_time(nanoseconds):
+	for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+		if nanoseconds >= scale:
+			return f"{nanoseconds / scale:.3f} {unit}"
+	return f"{nanoseconds:.1f} ns"
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Flag benchmark regressions between two Google Benchmark JSON runs")
+	parser.add_argument("baseline")
+	parser.add_argument("contender")
+	parser.add_argument("--threshold", type=float, default=0.05, help="relative slowdown that counts as a regression (default 0.05 = 5%%)")
+	parser.add_argument("--metric", choices=("real_time", "cpu_time"), default="real_time")
+	args = parser.parse_args()
+
+	baseline = load_results(args.baseline, args.metric)
+	contender = load_results(args.contender, args.metric)
+
+	common = [name for name in baseline if name in contender]
+	if not common:
+		sys.exit(f"No benchmarks in common between {args.baseline} ({len(baseline)}) and {args.contender} ({len(contender)}), nothing to compare")
+	width = max((len(name) for name in common), default=10)
+	print(f"{'benchmark':<{width}}  {'baseline':>12}  {'contender':>12}  {'change':>8}")
+
+	regressions = 0
+	for name in common:
+		before, after = baseline[name], contender[name]
+		change = (after - before) / before if before > 0 else 0.0
+		flag = ""
+		if change > args.threshold:
+			flag = "  REGRESSION"
+			regressions += 1
+		elif change < -args.threshold:
+			flag = "  faster"
+		print(f"{name:<{width}}  {format_time(before):>12}  {format_time(after):>12}  {change:>+8.1%}{flag}")
+
+	for name in baseline:
+		if name not in contender:
+			print(f"only in baseline: {name}")
+	for name in contender:
+		if name not in baseline:
+			print(f"only in contender: {name}")
+
+	print(f"\n{regressions} regression(s) over {args.threshold:.0%} in {len(common)} benchmark(s)")
+	return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,22 @@
+/*
+	Command line helpers shared by the programs. std::atoi and std::strtoull take "-5" or "abc" without complaining
+	(strtoull even turns -5 into 2^64 - 5), so counts that size a run or an allocation are read with parsePositive.
+*/
+#pragma once
+
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
+// Reads a whole number >= 1 that fits in T. False (and value untouched) for text, trailing characters, 0, negatives or overflow
+template <typename T>
+bool parsePositive(const char* text, T& value) {
+	if (!text || *text == '\0') return false;
+	char* end{ nullptr };
+	errno = 0;
+	long long parsed = std::strtoll(text, &end, 10);
+	if (errno == ERANGE || *end != '\0' || parsed < 1) return false;
+	if (static_cast<unsigned long long>(parsed) > static_cast<unsigned long long>(std::numeric_limits<T>::max())) return false;
+	value = static_cast<T>(parsed);
+	return true;
+}
@@ -0,0 +1,83 @@
+/*
+	Threads kept waiting between jobs, for code that splits one piece of work over several threads many times in a row
+	(PongBatch::step, LargeCopy's parallel copies). Starting the threads again for every job would cost more than the job
+	itself when it is small.
+
+	start() hands every worker the same job, called with the worker's index (0 to size() - 1), and wait() blocks until all
+	of them finished it. Only one job runs at a time, the caller is expected to do its own part between start() and wait().
+*/
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerThreads {
+public:
+	explicit WorkerThreads(unsigned count) {
+		for (unsigned i{ 0 }; i < count; ++i)
+			threads.emplace_back([this, i] { work(i); });
+	}
+
+	WorkerThreads(const WorkerThreads&) = delete;
+	WorkerThreads& operator=(const WorkerThreads&) = delete;
+
+	~WorkerThreads() {
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			stopping = true;
+		}
+		wake.notify_all();
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+
+	unsigned size() const {
+		return static_cast<unsigned>(threads.size());
+	}
+
+	// The job has to stay alive until wait() returns
+	void start(const std::function<void(unsigned)>& newJob) {
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			job = &newJob;
+			pending = size();
+			++generation;
+		}
+		wake.notify_all();
+	}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock{ mutex };
+		finished.wait(lock, [this] { return pending == 0; });
+	}
+
+private:
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable wake, finished;
+	const std::function<void(unsigned)>* job{ nullptr };
+	uint64_t generation{ 0 };
+	unsigned pending{ 0 };
+	bool stopping{ false };
+
+	void work(unsigned index) {
+		uint64_t done{ 0 };
+		std::unique_lock<std::mutex> lock{ mutex };
+		while (true) {
+			wake.wait(lock, [&] { return stopping || generation != done; });
+			if (stopping) return;
+			done = generation;
+			const std::function<void(unsigned)>* current = job;
+
+			lock.unlock();
+			(*current)(index);
+			lock.lock();
+
+			if (--pending == 0) finished.notify_one();
+		}
+	}
+};
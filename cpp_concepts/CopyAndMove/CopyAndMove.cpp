@@ -1,72 +1,12 @@
 /*
 Basic vector class implementation to better grasp the concepts of copy constructor/assignment and move constructor/assignment.
+The class itself lives in Vector.h.
 */
+#define VECTOR_VERBOSE // Before the include, so every constructor/assignment says when it runs
 
-/*
-Vector should have the ability to:
-	- Create it only based on its max capacity
-	- Create it from an existing vector
-	- Create it from a temporary object
-	- Assing it to an existing one
-	- Assign it to a temporary one
-*/
-#include <algorithm>
-#include <iostream>
 #include <utility>
 
-
-class Vector {
-private:
-	int size;
-	int* data;
-
-public:
-	Vector(int size)
-		: size{ size }, data{ new int[size] } {}
-
-	Vector(const Vector& other)
-		: size{ other.size }, data{ new int[other.size] } {
-		std::cout << "Vector(const Vector& other)" << std::endl;
-		std::copy(other.data, other.data + other.size, data);
-	}
-
-	Vector(Vector&& other) noexcept
-		: size{ other.size }, data{ other.data } {
-		std::cout << "Vector(Vector&& other)" << std::endl;
-
-		other.size = 0;
-		other.data = nullptr;
-	}
-
-	Vector& operator=(Vector& other) {
-		std::cout << "Vector& operator=(Vector& other)" << std::endl;
-		if (this != &other) {
-			delete[] data; // We have to make sure we don't leak memory
-
-			size = other.size;
-			data = new int[size];
-
-			std::copy(other.data, other.data + other.size, data);
-		}
-
-		return *this;
-	}
-	
-	Vector& operator=(Vector&& other) noexcept {
-		std::cout << "Vector& operator=(Vector&& other)" << std::endl;
-		if (this != &other) {
-			delete[] data;
-
-			size = other.size;
-			data = other.data; // No allocation needed, we are "stealing" the pointer
-
-			other.size = 0;
-			other.data = nullptr;
-		}
-
-		return *this;
-	}
-};
+#include "Vector.h"
 
 
 int main() {
@@ -88,4 +28,4 @@ int main() {
 	myV6 = Vector{ 6 };
 
 	return 0;
-}
\ No newline at end of file
+}
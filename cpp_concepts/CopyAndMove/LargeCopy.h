@@ -0,0 +1,194 @@
+/*
+Size tiered memory copy for big buffers, used by Vector's copies.
+
+	- Up to streamingThreshold bytes: std::memcpy, the copy probably fits in cache and will be read again soon.
+	- Above it: non-temporal (streaming) stores. A copy bigger than the last level cache would evict everything else
+	  just to write data that won't fit anyway, streaming stores go straight to memory without reading the destination
+	  lines first and without filling the cache.
+	- Above parallelThreshold (and with more than one hardware thread): the buffer is split in cache line aligned chunks,
+	  one per thread, each copied with streaming stores. One core alone usually can't saturate the memory bandwidth.
+	  The threads are started once and kept waiting for the next copy.
+
+copyToNew is for a destination that was just allocated (a copy constructor): none of its pages are mapped yet, and
+faulting them in one at a time while copying is what costs the most (about 2 GB/s against 15+ for the copy itself).
+From streamingThreshold up, every chunk is asked for huge pages and populated in one call (Linux madvise) by the
+thread that copies it, before copying.
+
+The thresholds default to the L3 size (when the OS tells it, 32 MB otherwise) and twice that, and can be changed.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "../../common/WorkerThreads.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LARGE_COPY_SSE 1
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// Bytes of L3 cache if the OS says, 32 MB otherwise
+inline size_t lastLevelCacheSize() {
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+	long size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+	if (size > 0) return static_cast<size_t>(size);
+#endif
+	return 32 << 20;
+}
+
+class LargeCopy {
+public:
+	enum class Strategy { AUTO, PLAIN, STREAMING, PARALLEL };
+
+	static constexpr size_t cacheLine{ 64 };
+
+	static inline size_t streamingThreshold = lastLevelCacheSize();
+	static inline size_t parallelThreshold = 2 * lastLevelCacheSize();
+	static inline unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	// Which strategy AUTO picks for a copy of `bytes`
+	static Strategy choose(size_t bytes) {
+		if (bytes >= parallelThreshold && maxThreads > 1) return Strategy::PARALLEL;
+		if (bytes >= streamingThreshold) return Strategy::STREAMING;
+		return Strategy::PLAIN;
+	}
+
+	static void copy(void* destination, const void* source, size_t bytes, Strategy strategy = Strategy::AUTO) {
+		copy(static_cast<char*>(destination), static_cast<const char*>(source), bytes, strategy, false);
+	}
+
+	// Same, into memory that was just allocated and never written
+	static void copyToNew(void* destination, const void* source, size_t bytes, Strategy strategy = Strategy::AUTO) {
+		copy(static_cast<char*>(destination), static_cast<const char*>(source), bytes, strategy, true);
+	}
+
+private:
+	static void copy(char* destination, const char* source, size_t bytes, Strategy strategy, bool fresh) {
+		if (strategy == Strategy::AUTO) strategy = choose(bytes);
+
+		switch (strategy) {
+		case Strategy::PARALLEL:
+			copyParallel(destination, source, bytes, fresh);
+			break;
+		case Strategy::STREAMING:
+			if (fresh) prefault(destination, bytes);
+			copyStreaming(destination, source, bytes);
+			break;
+		case Strategy::PLAIN:
+		default:
+			if (bytes > 0) std::memcpy(destination, source, bytes);
+		}
+	}
+
+	// Maps every whole page of the range now, with huge pages if the system gives them. Only a hint, nothing happens on other systems
+	static void prefault(char* destination, size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+		uintptr_t begin = (reinterpret_cast<uintptr_t>(destination) + pageSize - 1) & ~(pageSize - 1);
+		uintptr_t end = (reinterpret_cast<uintptr_t>(destination) + bytes) & ~(pageSize - 1);
+		if (begin >= end) return;
+		void* pages = reinterpret_cast<void*>(begin);
+		madvise(pages, end - begin, MADV_HUGEPAGE);
+#ifdef MADV_POPULATE_WRITE
+		madvise(pages, end - begin, MADV_POPULATE_WRITE); // Linux 5.14+, older ones fault the pages while copying like before
+#endif
+#else
+		(void)destination;
+		(void)bytes;
+#endif
+	}
+
+	// One pool for every copy, made on the first parallel one. The mutex is held for the whole copy
+	struct WorkerPool {
+		std::mutex mutex;
+		std::unique_ptr<WorkerThreads> workers;
+	};
+
+	static WorkerPool& workerPool() {
+		static WorkerPool pool;
+		return pool;
+	}
+	static void copyStreaming(char* destination, const char* source, size_t bytes) {
+#ifdef LARGE_COPY_SSE
+		// Plain copy up to the first 16 byte aligned destination address, the streaming stores need it
+		size_t head = std::min(bytes, (16 - (reinterpret_cast<uintptr_t>(destination) & 15)) & 15);
+		if (head > 0) std::memcpy(destination, source, head);
+		destination += head;
+		source += head;
+		bytes -= head;
+
+		// 64 bytes (a cache line) per iteration, so every line is written whole and never read
+		size_t blocks = bytes / 64;
+		for (size_t i{ 0 }; i < blocks; ++i) {
+			const __m128i* from = reinterpret_cast<const __m128i*>(source);
+			__m128i a = _mm_loadu_si128(from), b = _mm_loadu_si128(from + 1), c = _mm_loadu_si128(from + 2), d = _mm_loadu_si128(from + 3);
+			__m128i* to = reinterpret_cast<__m128i*>(destination);
+			_mm_stream_si128(to, a);
+			_mm_stream_si128(to + 1, b);
+			_mm_stream_si128(to + 2, c);
+			_mm_stream_si128(to + 3, d);
+			source += 64;
+			destination += 64;
+		}
+		_mm_sfence(); // Streaming stores aren't ordered with the normal ones, make them visible before returning
+
+		size_t tail = bytes - blocks * 64;
+		if (tail > 0) std::memcpy(destination, source, tail);
+#else
+		std::memcpy(destination, source, bytes);
+#endif
+	}
+
+	static void copyParallel(char* destination, const char* source, size_t bytes, bool fresh) {
+		// Another thread is using the workers, this copy runs on the calling thread instead of waiting for them
+		WorkerPool& pool = workerPool();
+		std::unique_lock<std::mutex> lock{ pool.mutex, std::try_to_lock };
+		if (!lock) {
+			if (fresh) prefault(destination, bytes);
+			copyStreaming(destination, source, bytes);
+			return;
+		}
+		const unsigned workerCount = std::max(1u, maxThreads) - 1; // The calling thread copies a chunk too
+		if (!pool.workers || pool.workers->size() != workerCount) pool.workers = std::make_unique<WorkerThreads>(workerCount);
+
+		unsigned threads = std::max(1u, std::min<unsigned>(maxThreads, static_cast<unsigned>(bytes / (4 << 20)))); // At least 4 MB each
+
+		// Split points on destination cache line boundaries, so no line is written by two threads
+		auto splitPoint = [&](unsigned t) {
+			if (t == 0) return size_t{ 0 };
+			if (t == threads) return bytes;
+			uintptr_t address = reinterpret_cast<uintptr_t>(destination) + bytes / threads * t;
+			address = (address + cacheLine - 1) & ~static_cast<uintptr_t>(cacheLine - 1);
+			return std::min(bytes, static_cast<size_t>(address - reinterpret_cast<uintptr_t>(destination)));
+		};
+
+		// Each thread maps the pages of its own chunk, so the page faults are spread over the threads too
+		auto copyChunk = [&](unsigned t) {
+			if (t >= threads) return; // Small copies don't need every worker
+			size_t begin = splitPoint(t), end = splitPoint(t + 1);
+			if (begin >= end) return;
+			if (fresh) prefault(destination + begin, end - begin);
+			copyStreaming(destination + begin, source + begin, end - begin);
+		};
+
+		std::function<void(unsigned)> workerJob = [&](unsigned worker) { copyChunk(worker + 1); };
+		pool.workers->start(workerJob);
+		copyChunk(0);
+		pool.workers->wait();
+	}
+};
@@ -0,0 +1,109 @@
+/*
+Basic vector class implementation to better grasp the concepts of copy constructor/assignment and move constructor/assignment.
+
+Vector should have the ability to:
+	- Create it only based on its max capacity
+	- Create it from an existing vector
+	- Create it from a temporary object
+	- Assing it to an existing one
+	- Assign it to a temporary one
+
+Define VECTOR_VERBOSE before including this header to see which constructor/assignment runs (CopyAndMove.cpp does, the
+benchmarks don't, printing would be all they measure).
+
+Copies go through LargeCopy, which picks memcpy, streaming stores or a multithreaded copy by size (copyToNew when the
+buffer was just allocated, so its pages get mapped up front), and copy assignment keeps the buffer it already has when
+it's big enough (capacity is what was allocated, size what's in use).
+*/
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#include "LargeCopy.h"
+
+#ifdef VECTOR_VERBOSE
+#define VECTOR_TRACE(message) (std::cout << message << std::endl)
+#else
+#define VECTOR_TRACE(message) ((void)0)
+#endif
+
+
+class Vector {
+private:
+	int size;
+	int capacity;
+	int* data;
+
+public:
+	Vector(int size)
+		: size{ size }, capacity{ size }, data{ new int[size] } {}
+
+	Vector(const Vector& other)
+		: size{ other.size }, capacity{ other.size }, data{ new int[other.size] } {
+		VECTOR_TRACE("Vector(const Vector& other)");
+		LargeCopy::copyToNew(data, other.data, bytesOf(other));
+	}
+
+	Vector(Vector&& other) noexcept
+		: size{ other.size }, capacity{ other.capacity }, data{ other.data } {
+		VECTOR_TRACE("Vector(Vector&& other)");
+
+		other.size = 0;
+		other.capacity = 0;
+		other.data = nullptr;
+	}
+
+	~Vector() {
+		delete[] data;
+	}
+
+	Vector& operator=(const Vector& other) {
+		VECTOR_TRACE("Vector& operator=(const Vector& other)");
+		if (this != &other) {
+			// Only reallocate if what we have doesn't fit it, otherwise the buffer is just overwritten
+			if (capacity < other.size) {
+				int* newData = new int[other.size]; // Allocate before deleting, if new throws we still have our data
+				delete[] data; // We have to make sure we don't leak memory
+				data = newData;
+				capacity = other.size;
+				size = other.size;
+				LargeCopy::copyToNew(data, other.data, bytesOf(other));
+				return *this;
+			}
+
+			size = other.size;
+			LargeCopy::copy(data, other.data, bytesOf(other));
+		}
+
+		return *this;
+	}
+	
+	Vector& operator=(Vector&& other) noexcept {
+		VECTOR_TRACE("Vector& operator=(Vector&& other)");
+		if (this != &other) {
+			delete[] data;
+
+			size = other.size;
+			capacity = other.capacity;
+			data = other.data; // No allocation needed, we are "stealing" the pointer
+
+			other.size = 0;
+			other.capacity = 0;
+			other.data = nullptr;
+		}
+
+		return *this;
+	}
+
+	int getSize() const { return size; }
+	int getCapacity() const { return capacity; }
+	int& operator[](int i) { return data[i]; }
+	const int& operator[](int i) const { return data[i]; }
+
+private:
+	static size_t bytesOf(const Vector& vector) {
+		return static_cast<size_t>(vector.size) * sizeof(int);
+	}
+};
@@ -0,0 +1,259 @@
+/*
+Fixed size array of ints, on the heap or backed by a file.
+
+Array::openFile maps the file into memory instead of reading it, so opening is the same instant no matter how big the
+array is: pages are only read from disk the first time they are touched, and a new file is created sparse so growing it
+doesn't write anything either. insert/remove write straight into the mapping, the OS writes the dirty pages back on its
+own and sync() forces it. adviseAccess() tells the OS how the array will be read (read ahead for sequential scans,
+none for random access).
+
+File layout: a 16 byte header ("INTARRAY" + the element count as int64) followed by the ints.
+*/
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class Array {
+public:
+	enum class Access { NORMAL, SEQUENTIAL, RANDOM };
+
+private:
+	struct FileHeader {
+		char magic[8];
+		int64_t size;
+	};
+	static constexpr char fileMagic[8]{ 'I', 'N', 'T', 'A', 'R', 'R', 'A', 'Y' };
+
+	int* arr_ptr;
+	int size;
+
+	// Only set for file backed arrays
+	char* mapping{ nullptr };
+	size_t mappingBytes{ 0 };
+#ifdef _WIN32
+	HANDLE file{ INVALID_HANDLE_VALUE };
+	HANDLE fileMapping{ nullptr };
+#endif
+
+	Array()
+		: arr_ptr{ nullptr }, size{ 0 } {}
+
+public:
+	Array(int size)
+		: arr_ptr{ new int[size] }, size{ size } {}
+
+	/*
+		Opens (or creates) a file backed array. `size` = 0 keeps the size stored in the file, anything else resizes the file
+		to it (new elements are 0). Throws std::runtime_error if the file can't be opened, isn't an array file or is shorter
+		than its header says. A file this call created is deleted again if it fails.
+	*/
+	static Array openFile(const std::string& filename, int size = 0) {
+		Array array;
+		int64_t storedSize{ -1 }; // -1: new or empty file
+		uint64_t fileSize{ 0 };
+		bool created{ false };
+
+#ifdef _WIN32
+		array.file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (array.file == INVALID_HANDLE_VALUE) throw std::runtime_error("Can't open " + filename);
+		created = GetLastError() != ERROR_ALREADY_EXISTS;
+		auto fail = [&](const std::string& message) {
+			array.closeFile();
+			if (created) DeleteFileA(filename.c_str());
+			throw std::runtime_error(message);
+		};
+
+		LARGE_INTEGER length;
+		if (!GetFileSizeEx(array.file, &length)) fail("Can't read " + filename);
+		fileSize = static_cast<uint64_t>(length.QuadPart);
+		if (fileSize >= sizeof(FileHeader)) {
+			FileHeader header;
+			DWORD read{ 0 };
+			if (!ReadFile(array.file, &header, sizeof(header), &read, nullptr) || read != sizeof(header)) fail("Can't read " + filename);
+			storedSize = checkHeader(header);
+		}
+#else
+		int descriptor = open(filename.c_str(), O_RDWR);
+		if (descriptor < 0 && errno == ENOENT) {
+			descriptor = open(filename.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+			created = descriptor >= 0;
+		}
+		if (descriptor < 0) throw std::runtime_error("Can't open " + filename);
+		auto fail = [&](const std::string& message) {
+			close(descriptor);
+			if (created) unlink(filename.c_str());
+			throw std::runtime_error(message);
+		};
+
+		struct stat status;
+		if (fstat(descriptor, &status) != 0) fail("Can't read " + filename);
+		fileSize = static_cast<uint64_t>(status.st_size);
+		if (fileSize >= sizeof(FileHeader)) {
+			FileHeader header;
+			if (pread(descriptor, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) fail("Can't read " + filename);
+			storedSize = checkHeader(header);
+		}
+#endif
+
+		if (fileSize > 0 && fileSize < sizeof(FileHeader)) storedSize = -2; // Something else, not an empty file we can use
+		if (storedSize == -2) fail(filename + " is not an array file");
+		if (size <= 0) {
+			if (storedSize < 0) fail(filename + " is not an array yet, a size is needed to create it");
+			size = static_cast<int>(storedSize);
+		}
+		array.size = size;
+		array.mappingBytes = sizeof(FileHeader) + static_cast<size_t>(size) * sizeof(int);
+
+		// Mapping past the end of the file would crash (SIGBUS) on the first access there, so the length has to be right.
+		// Growing it is fine when the size changes (the new elements are 0), but a file shorter than its own header says lost data
+		if (storedSize == size && fileSize < array.mappingBytes) fail(filename + " is truncated");
+
+#ifdef _WIN32
+		// Mapping a file bigger than it is grows it
+		array.fileMapping = CreateFileMappingA(array.file, nullptr, PAGE_READWRITE, static_cast<DWORD>(array.mappingBytes >> 32), static_cast<DWORD>(array.mappingBytes), nullptr);
+		if (array.fileMapping) array.mapping = static_cast<char*>(MapViewOfFile(array.fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, array.mappingBytes));
+		if (!array.mapping) fail("Can't map " + filename);
+#else
+		// Only changes the length, a new part is a hole that reads as 0 and takes no disk space until written
+		if (fileSize != array.mappingBytes && ftruncate(descriptor, static_cast<off_t>(array.mappingBytes)) != 0) fail("Can't resize " + filename);
+		void* mapped = mmap(nullptr, array.mappingBytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+		if (mapped == MAP_FAILED) fail("Can't map " + filename);
+		close(descriptor); // The mapping keeps the file open
+		array.mapping = static_cast<char*>(mapped);
+#endif
+
+		// Only when it changes, writing the same bytes would still dirty the first page and make the OS write it back
+		if (storedSize != size) {
+			FileHeader header;
+			std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+			header.size = size;
+			std::memcpy(array.mapping, &header, sizeof(header));
+		}
+		array.arr_ptr = reinterpret_cast<int*>(array.mapping + sizeof(FileHeader));
+		return array;
+	}
+
+	// Copying would mean two owners of the same buffer (or mapping), moving is fine
+	Array(const Array&) = delete;
+	Array& operator=(const Array&) = delete;
+
+	Array(Array&& other) noexcept
+		: Array() {
+		*this = std::move(other);
+	}
+
+	Array& operator=(Array&& other) noexcept {
+		if (this != &other) {
+			release();
+			std::swap(arr_ptr, other.arr_ptr);
+			std::swap(size, other.size);
+			std::swap(mapping, other.mapping);
+			std::swap(mappingBytes, other.mappingBytes);
+#ifdef _WIN32
+			std::swap(file, other.file);
+			std::swap(fileMapping, other.fileMapping);
+#endif
+		}
+		return *this;
+	}
+
+	~Array() {
+		release();
+	}
+
+	void insert(int idx, int value) {
+		if (!arr_ptr) return;
+		arr_ptr[idx] = value;
+	}
+
+	void remove(int idx) {
+		if (!arr_ptr) return;
+		arr_ptr[idx] = -1; // Default value
+	}
+
+	int getValue(int idx) const {
+		if (idx < 0 || idx >= size)
+			return -1;
+		return arr_ptr[idx];
+	}
+
+	int getSize() const {
+		return size;
+	}
+
+	bool isFileBacked() const {
+		return mapping != nullptr;
+	}
+
+	// Hint for the pages not read yet. Does nothing on a heap array (or on Windows)
+	void adviseAccess(Access access) const {
+#ifndef _WIN32
+		if (!mapping) return;
+		int advice = (access == Access::SEQUENTIAL) ? MADV_SEQUENTIAL : (access == Access::RANDOM) ? MADV_RANDOM : MADV_NORMAL;
+		madvise(mapping, mappingBytes, advice);
+#else
+		(void)access;
+#endif
+	}
+
+	// Blocks until every write so far is on disk. True on a heap array, there's nothing to write
+	bool sync() const {
+		if (!mapping) return true;
+#ifdef _WIN32
+		return FlushViewOfFile(mapping, mappingBytes) && FlushFileBuffers(file);
+#else
+		return msync(mapping, mappingBytes, MS_SYNC) == 0;
+#endif
+	}
+
+private:
+	// The element count in the header, -2 if it isn't an array file
+	static int64_t checkHeader(const FileHeader& header) {
+		if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 || header.size < 0 || header.size > INT32_MAX)
+			return -2;
+		return header.size;
+	}
+
+	void closeFile() {
+#ifdef _WIN32
+		if (fileMapping) CloseHandle(fileMapping);
+		if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+		fileMapping = nullptr;
+		file = INVALID_HANDLE_VALUE;
+#endif
+	}
+
+	void release() {
+		if (mapping) {
+#ifdef _WIN32
+			UnmapViewOfFile(mapping);
+#else
+			munmap(mapping, mappingBytes); // Dirty pages still get written back, sync() only makes it happen now
+#endif
+		}
+		else delete[] arr_ptr;
+		closeFile();
+
+		arr_ptr = nullptr;
+		size = 0;
+		mapping = nullptr;
+		mappingBytes = 0;
+	}
+};
@@ -1,40 +1,11 @@
+#include <cstring>
+#include <fstream>
 #include <iostream>
 
-class Array {
-private:
-	int* arr_ptr;
-	int size;
-
-public:
-	Array(int size)
-		: arr_ptr{ new int[size] }, size{ size } {}
-
-	~Array() {
-		delete[] arr_ptr;
-	}
-
-	void insert(int idx, int value) {
-		if (!arr_ptr) return;
-		arr_ptr[idx] = value;
-	}
-
-	void remove(int idx) {
-		if (!arr_ptr) return;
-		arr_ptr[idx] = -1; // Default value
-	}
-	
-	int getValue(int idx) const {
-		if (idx > size)
-			return -1;
-		return arr_ptr[idx];
-	}
-
-	int getSize() const {
-		return size;
-	}
-};
+#include "Array.h"
 
-Array populateArrayInteractively() {
+// With a filename the array lives in that file instead of the heap
+Array populateArrayInteractively(const char* filename = nullptr) {
 	int size;
 	int length;
 
@@ -49,7 +20,7 @@ Array populateArrayInteractively() {
 		throw 1;
 	}
 
-	Array builtArr(size);
+	Array builtArr = filename ? Array::openFile(filename, size) : Array(size);
 
 	int numToAdd;
 	std::cout << "Enter elements: ";
@@ -68,10 +39,30 @@ void displayArray(const Array& arr) {
 	}
 }
 
-int main() {
-	
-	Array arr = populateArrayInteractively();
-	displayArray(arr);
+/*
+	BasicArray --file <path> keeps the array in <path>: the first run asks for it and saves it, the next ones just open
+	the file and print it.
+*/
+int main(int argc, char** argv) {
+	const char* filename = (argc > 2 && std::strcmp(argv[1], "--file") == 0) ? argv[2] : nullptr;
+
+	try {
+		if (filename && std::ifstream{ filename }.good()) {
+			Array arr = Array::openFile(filename);
+			arr.adviseAccess(Array::Access::SEQUENTIAL);
+			displayArray(arr);
+			return 0;
+		}
+
+		Array arr = populateArrayInteractively(filename);
+		if (!arr.sync())
+			std::cerr << "Error: couldn't write the array to " << filename << "\n";
+		displayArray(arr);
+	}
+	catch (const std::runtime_error& e) {
+		std::cerr << "Error: " << e.what() << "\n";
+		return 1;
+	}
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+
+class EnemyShip {
+protected:
+	std::string name;
+	float amountDamage;
+
+public:
+	virtual ~EnemyShip() = default; // Ships are deleted through EnemyShip pointers
+
+	const std::string& getName() const { return name; }
+	float getDamage() const { return amountDamage; }
+
+	void followHero() {
+		std::cout << name << " is following the hero." << std::endl;
+	}
+
+	void displayShip() {
+		std::cout << name << " is on screen." << std::endl;
+	}
+
+	void shoot() {
+		std::cout << name << " attacks hero and deals " << amountDamage << "." << std::endl;
+	}
+};
+
+
+class UFOEnemyShip : public EnemyShip {
+public:
+	UFOEnemyShip() {
+		name = "UFO";
+		amountDamage = 15;
+	}
+};
+
+class RocketEnemyShip : public EnemyShip {
+public:
+	RocketEnemyShip() {
+		name = "Rocket";
+		amountDamage = 30;
+	}
+};
+
+class EnemyShipFactory {
+public:
+	EnemyShip* makeEnemyShip(char typeShip) {
+		EnemyShip* enemyShip; // I have a question here, does this force object slicing?
+		switch (typeShip) {
+			case 'U':
+				enemyShip = new UFOEnemyShip();
+				break;
+			case 'R':
+				enemyShip = new RocketEnemyShip();
+				break;
+			default:
+				enemyShip = new UFOEnemyShip();
+		}
+		return enemyShip;
+	}
+};
@@ -0,0 +1,59 @@
+/*
+The ships only differ in their name and damage, so they don't really need to live behind pointers. This factory returns
+them by value as a std::variant of ShipType instantiations. They don't derive from EnemyShip, so they have no vtable
+pointer and no std::string: the name is part of the type and only the damage is stored. A variant of them is the damage
+plus the type index (8 bytes), a vector of them stores every ship inline (no allocation per ship, no pointer to follow),
+and std::visit switches on the index to run the right type's code.
+
+The catch is that the set of ships is closed, adding a new one means adding it to EnemyShipVariant too.
+*/
+#pragma once
+
+#include <iostream>
+#include <string_view>
+#include <variant>
+
+
+// Name is the type, the damage is in every ship like in EnemyShip. DefaultDamage is what the factory gives it
+template <const char* Name, int DefaultDamage>
+struct ShipType {
+	static constexpr std::string_view name{ Name };
+
+	float damage{ DefaultDamage };
+
+	std::string_view getName() const { return name; }
+	float getDamage() const { return damage; }
+
+	void followHero() const {
+		std::cout << name << " is following the hero." << std::endl;
+	}
+
+	void displayShip() const {
+		std::cout << name << " is on screen." << std::endl;
+	}
+
+	void shoot() const {
+		std::cout << name << " attacks hero and deals " << damage << "." << std::endl;
+	}
+};
+
+inline constexpr char ufoName[]{ "UFO" };
+inline constexpr char rocketName[]{ "Rocket" };
+
+using UFOShip = ShipType<ufoName, 15>;
+using RocketShip = ShipType<rocketName, 30>;
+
+using EnemyShipVariant = std::variant<UFOShip, RocketShip>;
+
+class EnemyShipVariantFactory {
+public:
+	EnemyShipVariant makeEnemyShip(char typeShip) const {
+		switch (typeShip) {
+			case 'R':
+				return RocketShip{};
+			case 'U':
+			default:
+				return UFOShip{};
+		}
+	}
+};
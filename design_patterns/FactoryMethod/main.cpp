@@ -4,64 +4,11 @@ This code is my C++ implementation based off of Derek Banas' Java code.
 First as in the video, I'm going to write how the program would be without the pattern
 and then I will implement the pattern.
 */
-#include <string>
 #include <iostream>
+#include <variant>
 
-
-class EnemyShip {
-protected:
-	std::string name;
-	float amountDamage;
-
-public:
-
-	void followHero() {
-		std::cout << name << " is following the hero." << std::endl;
-	}
-
-	void displayShip() {
-		std::cout << name << " is on screen." << std::endl;
-	}
-
-	void shoot() {
-		std::cout << name << " attacks hero and deals " << amountDamage << "." << std::endl;
-	}
-};
-
-
-class UFOEnemyShip : public EnemyShip {
-public:
-	UFOEnemyShip() {
-		name = "UFO";
-		amountDamage = 15;
-	}
-};
-
-class RocketEnemyShip : public EnemyShip {
-public:
-	RocketEnemyShip() {
-		name = "Rocket";
-		amountDamage = 30;
-	}
-};
-
-class EnemyShipFactory {
-public:
-	EnemyShip* makeEnemyShip(char typeShip) {
-		EnemyShip* enemyShip; // I have a question here, does this force object slicing?
-		switch (typeShip) {
-			case 'U':
-				enemyShip = new UFOEnemyShip();
-				break;
-			case 'R':
-				enemyShip = new RocketEnemyShip();
-				break;
-			default:
-				enemyShip = new UFOEnemyShip();
-		}
-		return enemyShip;
-	}
-};
+#include "EnemyShip.h"
+#include "EnemyShipVariant.h"
 
 void doEnemyStuff(EnemyShip &ship) {
 	ship.displayShip();
@@ -81,5 +28,15 @@ int main() {
 	doEnemyStuff(*enemyShip);
 
 	delete enemyShip;
+
+	// Same ship by value, no new/delete
+	EnemyShipVariantFactory variantFactory;
+	EnemyShipVariant ship = variantFactory.makeEnemyShip(enemyUserOption);
+	std::visit([](const auto& concreteShip) {
+		concreteShip.displayShip();
+		concreteShip.followHero();
+		concreteShip.shoot();
+	}, ship);
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "JournalIndex.h"
+
+
+class Journal {
+public:
+	std::string title;
+	std::vector<std::string> entries;
+	JournalIndex index; // Word -> entries, kept up to date by add
+
+	explicit Journal(const std::string& title)
+		: title{ title } {}
+
+	void add(const std::string& entry);
+
+	// Positions in entries of the ones with all (Match::ALL) or any (Match::ANY) of the words in query
+	std::vector<uint32_t> search(std::string_view query, JournalIndex::Match match = JournalIndex::Match::ALL) const {
+		return index.search(query, match);
+	}
+
+	void save(const std::string& filename);
+};
+
+inline void Journal::add(const std::string& entry) {
+	index.add(static_cast<uint32_t>(entries.size()), entry);
+	entries.push_back(std::to_string(entries.size() + 1) + ": " + entry);
+}
+
+// The responsability of saving entries is the journal's and the responsability of saving the Journal is some other object's
+
+class JournalSaver {
+public:
+	/*
+		The entries go to filename, one per line, and the index next to it in filename + ".index". The index keeps the
+		checksum of the entries it was saved with, so load() can tell when the file was edited since.
+	*/
+	static void save(Journal& j, std::string filename) {
+		std::ofstream ofs{ filename };
+		uint64_t checksum{ checksumStart };
+		for (auto& entry : j.entries) {
+			ofs << entry << '\n';
+			checksum = addToChecksum(checksum, entry);
+		}
+		ofs.close();
+
+		std::ofstream indexFile{ indexFilename(filename), std::ios::binary };
+		j.index.write(indexFile, checksum);
+	}
+
+	// The saved index is used if it's there and was saved with these same entries, otherwise it's built again from them
+	static Journal load(const std::string& filename, const std::string& title) {
+		Journal j{ title };
+		std::ifstream ifs{ filename };
+		std::string entry;
+		uint64_t checksum{ checksumStart };
+		while (std::getline(ifs, entry)) {
+			checksum = addToChecksum(checksum, entry);
+			j.entries.push_back(entry);
+		}
+
+		std::ifstream indexFile{ indexFilename(filename), std::ios::binary };
+		uint64_t savedChecksum{ 0 };
+		if (!indexFile || !j.index.read(indexFile, &savedChecksum) || savedChecksum != checksum || j.index.getEntryCount() != j.entries.size()) {
+			j.index.clear();
+			for (size_t i{ 0 }; i < j.entries.size(); ++i) {
+				std::string_view text{ j.entries[i] };
+				size_t numberEnd = text.find(": "); // Without the "<number>: " add puts in front
+				j.index.add(static_cast<uint32_t>(i), (numberEnd == std::string_view::npos) ? text : text.substr(numberEnd + 2));
+			}
+		}
+		return j;
+	}
+
+	static std::string indexFilename(const std::string& filename) {
+		return filename + ".index";
+	}
+
+private:
+	// FNV-1a over every line and its newline. The entry count alone misses an entry edited in place
+	static constexpr uint64_t checksumStart{ 14695981039346656037ull };
+
+	static uint64_t addToChecksum(uint64_t checksum, const std::string& line) {
+		for (unsigned char c : line) checksum = (checksum ^ c) * 1099511628211ull;
+		return (checksum ^ '\n') * 1099511628211ull;
+	}
+};
@@ -0,0 +1,369 @@
+/*
+Inverted index for the Journal: every word points to the list of entries that have it, so a search only reads the lists of
+the words searched instead of every entry.
+
+Words are runs of letters/digits (and any non ASCII byte, so UTF-8 words stay whole), lowercased. Entries are numbered by
+their position in the Journal and always added in order, so each list is sorted and is stored as the differences between
+consecutive entry numbers, 7 bits per byte (varint). The common words have a difference of 1 or 2 most of the time,
+that's one byte per entry instead of four.
+
+Every skipEvery entries a list keeps a skip (the entry number before it and where it starts in the bytes), so a search can
+jump close to an entry number with a binary search instead of decoding everything before it. Searching for all of the
+words walks the shortest list and jumps forward in the others (leapfrog), so the time depends on the shortest list, not
+on how common the other words are.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+class JournalIndex {
+public:
+	enum class Match { ALL, ANY };
+
+	static constexpr uint32_t skipEvery{ 128 };
+
+	struct Skip {
+		uint32_t base; // Entry number right before the block
+		uint32_t offset; // Where the block starts in bytes
+	};
+
+	struct Postings {
+		std::vector<uint8_t> bytes;
+		std::vector<Skip> skips;
+		uint32_t count{ 0 };
+		uint32_t last{ 0 };
+	};
+
+	// Reads a list in order, next() decodes one entry number and advanceTo() uses the skips
+	class Cursor {
+	public:
+		explicit Cursor(const Postings* postings)
+			: postings{ postings } {
+			next();
+		}
+
+		bool atEnd() const { return ended; }
+		uint32_t value() const { return current; }
+
+		void next() {
+			if (offset >= postings->bytes.size()) {
+				ended = true;
+				return;
+			}
+			current += readVarint(postings->bytes.data(), offset);
+		}
+
+		// Moves to the first entry number >= target, false if there is none
+		bool advanceTo(uint32_t target) {
+			if (ended) return false;
+			if (current >= target) return true;
+
+			// Last skip before target, only if it's ahead of where the cursor is
+			const std::vector<Skip>& skips = postings->skips;
+			auto skip = std::lower_bound(skips.begin(), skips.end(), target, [](const Skip& s, uint32_t t) { return s.base < t; });
+			if (skip != skips.begin() && (--skip)->offset > offset) {
+				offset = skip->offset;
+				current = skip->base;
+			}
+
+			do next();
+			while (!ended && current < target);
+			return !ended;
+		}
+
+	private:
+		const Postings* postings;
+		size_t offset{ 0 };
+		uint32_t current{ 0 };
+		bool ended{ false };
+	};
+
+	// entry has to be bigger than every entry added before
+	void add(uint32_t entry, std::string_view text) {
+		entryCount = entry + 1;
+		forEachToken(text, [&](const std::string& token) {
+			Postings& postings = tokens[token];
+			if (postings.count > 0 && postings.last == entry) return; // Same word twice in the entry
+
+			if (postings.count > 0 && postings.count % skipEvery == 0)
+				postings.skips.push_back({ postings.last, static_cast<uint32_t>(postings.bytes.size()) });
+			writeVarint(postings.bytes, entry - postings.last);
+			postings.last = entry;
+			++postings.count;
+		});
+	}
+
+	// Entry numbers (sorted) with all the words in query (Match::ALL) or at least one of them (Match::ANY)
+	std::vector<uint32_t> search(std::string_view query, Match match = Match::ALL) const {
+		std::vector<const Postings*> lists;
+		bool missingWord{ false };
+		forEachToken(query, [&](const std::string& token) {
+			auto it = tokens.find(token);
+			if (it == tokens.end()) missingWord = true;
+			else if (std::find(lists.begin(), lists.end(), &it->second) == lists.end()) lists.push_back(&it->second);
+		});
+
+		if (match == Match::ANY) return unite(lists);
+		if (missingWord) return {};
+		return intersect(lists);
+	}
+
+	// Null if no entry has the word
+	const Postings* find(std::string_view word) const {
+		std::string token;
+		forEachToken(word, [&](const std::string& t) { if (token.empty()) token = t; });
+		auto it = tokens.find(token);
+		return (it == tokens.end()) ? nullptr : &it->second;
+	}
+
+	uint32_t getEntryCount() const { return entryCount; }
+	size_t getWordCount() const { return tokens.size(); }
+
+	// Bytes used by the lists and skips (not counting the hash table)
+	size_t getPostingsBytes() const {
+		size_t bytes{ 0 };
+		for (const auto& [token, postings] : tokens) bytes += postings.bytes.size() + postings.skips.size() * sizeof(Skip);
+		return bytes;
+	}
+
+	void clear() {
+		tokens.clear();
+		entryCount = 0;
+	}
+
+	/*
+		Binary format: "JIDX0002", the source checksum, the entry count, the word count, then for every word its length and
+		characters, count, last, the list bytes and the skips. All the numbers are varints.
+		The source checksum isn't used by the index, it's whatever the caller wants to recognize the text it was built from
+		by (JournalSaver puts the checksum of the journal file there).
+	*/
+	void write(std::ostream& out, uint64_t sourceChecksum = 0) const {
+		out.write(fileMagic, sizeof(fileMagic));
+		std::vector<uint8_t> buffer;
+		writeVarint(buffer, sourceChecksum);
+		writeVarint(buffer, entryCount);
+		writeVarint(buffer, tokens.size());
+		for (const auto& [token, postings] : tokens) {
+			writeVarint(buffer, token.size());
+			buffer.insert(buffer.end(), token.begin(), token.end());
+			writeVarint(buffer, postings.count);
+			writeVarint(buffer, postings.last);
+			writeVarint(buffer, postings.bytes.size());
+			buffer.insert(buffer.end(), postings.bytes.begin(), postings.bytes.end());
+			writeVarint(buffer, postings.skips.size());
+			for (const Skip& skip : postings.skips) {
+				writeVarint(buffer, skip.base);
+				writeVarint(buffer, skip.offset);
+			}
+
+			if (buffer.size() >= (1 << 16)) {
+				out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+				buffer.clear();
+			}
+		}
+		out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+	}
+
+	// Replaces the index with the one in `in`. False (and an empty index) if it isn't a valid index. The source checksum
+	// it was written with goes to sourceChecksum
+	bool read(std::istream& in, uint64_t* sourceChecksum = nullptr) {
+		clear();
+		std::vector<uint8_t> data{ std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+		if (data.size() < sizeof(fileMagic) || std::memcmp(data.data(), fileMagic, sizeof(fileMagic)) != 0) return false;
+
+		size_t offset{ sizeof(fileMagic) };
+		bool valid{ true };
+		// Bounds checked readVarint, a truncated file just makes the read fail
+		auto number = [&]() -> uint64_t {
+			uint64_t value{ 0 };
+			for (int shift{ 0 }; shift < 64; shift += 7) {
+				if (offset >= data.size()) break;
+				uint8_t byte = data[offset++];
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) return value;
+			}
+			valid = false;
+			return 0;
+		};
+		auto bytes = [&](uint64_t count) {
+			if (count > data.size() - offset) {
+				valid = false;
+				count = 0;
+			}
+			const uint8_t* first = data.data() + offset;
+			offset += count;
+			return std::vector<uint8_t>(first, first + count);
+		};
+
+		auto number32 = [&]() -> uint32_t {
+			uint64_t value = number();
+			if (value > UINT32_MAX) valid = false;
+			return static_cast<uint32_t>(value);
+		};
+
+		uint64_t source = number();
+		if (sourceChecksum) *sourceChecksum = source;
+		entryCount = number32();
+		uint64_t wordCount = number();
+		tokens.reserve(static_cast<size_t>(std::min<uint64_t>(wordCount, data.size())));
+		for (uint64_t w{ 0 }; w < wordCount && valid; ++w) {
+			std::vector<uint8_t> token = bytes(number());
+			auto [it, added] = tokens.try_emplace(std::string{ token.begin(), token.end() });
+			if (!added) valid = false; // Every word once
+			Postings& postings = it->second;
+			postings.count = number32();
+			postings.last = number32();
+			postings.bytes = bytes(number());
+			uint64_t skipCount = number();
+			for (uint64_t s{ 0 }; s < skipCount && valid; ++s) {
+				Skip skip;
+				skip.base = number32();
+				skip.offset = number32();
+				postings.skips.push_back(skip);
+			}
+			// The Cursor trusts the lists, so a damaged one has to be caught here and not in the middle of a search
+			if (valid) valid = checkPostings(postings);
+		}
+
+		if (!valid) clear();
+		return valid;
+	}
+
+	// Calls f(const std::string&) with every word of text, lowercased
+	template <typename F>
+	static void forEachToken(std::string_view text, F&& f) {
+		std::string token;
+		for (size_t i{ 0 }; i <= text.size(); ++i) {
+			unsigned char c = (i < text.size()) ? static_cast<unsigned char>(text[i]) : ' ';
+			if (std::isalnum(c) || c >= 0x80) {
+				token.push_back(static_cast<char>(std::tolower(c)));
+			}
+			else if (!token.empty()) {
+				f(token);
+				token.clear();
+			}
+		}
+	}
+
+private:
+	static constexpr char fileMagic[8]{ 'J', 'I', 'D', 'X', '0', '0', '0', '2' };
+
+	std::unordered_map<std::string, Postings> tokens;
+	uint32_t entryCount{ 0 };
+
+	static void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<uint8_t>(value) | 0x80);
+			value >>= 7;
+		}
+		out.push_back(static_cast<uint8_t>(value));
+	}
+
+	static uint32_t readVarint(const uint8_t* data, size_t& offset) {
+		uint32_t value{ 0 };
+		int shift{ 0 };
+		uint8_t byte;
+		do {
+			byte = data[offset++];
+			value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+			shift += 7;
+		} while (byte & 0x80);
+		return value;
+	}
+
+	/*
+		Decodes the whole list once: every varint has to end inside the bytes, the entry numbers have to go up and be below
+		entryCount, count and last have to match what was decoded, and the skips have to be exactly the ones add would
+		have made (so a skip always lands at the start of a varint with the right base).
+	*/
+	bool checkPostings(const Postings& postings) const {
+		const std::vector<uint8_t>& bytes = postings.bytes;
+		size_t offset{ 0 };
+		uint64_t entry{ 0 };
+		uint32_t decoded{ 0 };
+		while (offset < bytes.size()) {
+			if (decoded > 0 && decoded % skipEvery == 0) {
+				size_t skip = decoded / skipEvery - 1;
+				if (skip >= postings.skips.size() || postings.skips[skip].base != entry || postings.skips[skip].offset != offset) return false;
+			}
+
+			uint64_t gap{ 0 };
+			int shift{ 0 };
+			uint8_t byte;
+			do {
+				if (offset >= bytes.size() || shift > 28) return false;
+				byte = bytes[offset++];
+				gap |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				shift += 7;
+			} while (byte & 0x80);
+
+			if (gap == 0 && decoded > 0) return false; // The same entry twice
+			entry += gap;
+			if (entry >= entryCount) return false;
+			++decoded;
+		}
+		return decoded == postings.count && decoded > 0 && entry == postings.last
+			&& postings.skips.size() == (decoded - 1) / skipEvery;
+	}
+
+	// Walks the shortest list and moves the others up to each of its entries
+	static std::vector<uint32_t> intersect(std::vector<const Postings*> lists) {
+		std::vector<uint32_t> result;
+		if (lists.empty()) return result;
+		std::sort(lists.begin(), lists.end(), [](const Postings* a, const Postings* b) { return a->count < b->count; });
+
+		std::vector<Cursor> cursors(lists.begin(), lists.end());
+		Cursor& driver = cursors[0];
+		while (!driver.atEnd()) {
+			uint32_t candidate = driver.value();
+			bool inAll{ true };
+			for (size_t i{ 1 }; i < cursors.size(); ++i) {
+				if (!cursors[i].advanceTo(candidate)) return result;
+				if (cursors[i].value() != candidate) {
+					candidate = cursors[i].value(); // Nothing before this one can be in every list
+					inAll = false;
+					break;
+				}
+			}
+
+			if (inAll) {
+				result.push_back(candidate);
+				driver.next();
+			}
+			else driver.advanceTo(candidate);
+		}
+		return result;
+	}
+
+	// Merge, a handful of words so the smallest is looked for linearly
+	static std::vector<uint32_t> unite(const std::vector<const Postings*>& lists) {
+		std::vector<uint32_t> result;
+		std::vector<Cursor> cursors(lists.begin(), lists.end());
+		while (true) {
+			bool anyLeft{ false };
+			uint32_t smallest{ UINT32_MAX };
+			for (const Cursor& cursor : cursors) {
+				if (cursor.atEnd()) continue;
+				anyLeft = true;
+				smallest = std::min(smallest, cursor.value());
+			}
+			if (!anyLeft) return result;
+
+			result.push_back(smallest);
+			for (Cursor& cursor : cursors) {
+				if (!cursor.atEnd() && cursor.value() == smallest) cursor.next();
+			}
+		}
+	}
+};
@@ -0,0 +1,124 @@
+/*
+	Generates product catalogs and filters them with ProductCatalog, reporting rows/s and the peak resident memory.
+
+	Usage:
+		CatalogTool generate <file> [rows = 10000000]
+		CatalogTool filter <file> [threads = hardware threads] [batch size = 4096]
+*/
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "../../common/CommandLine.h"
+#include "ProductCatalog.h"
+
+double peakResidentMegabytes() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss / 1024.0; // Kilobytes on Linux
+#endif
+}
+
+int generate(const char* filename, uint64_t rows) {
+	std::ofstream ofs{ filename, std::ios::binary };
+	if (!ofs) {
+		std::cerr << "Can't write " << filename << std::endl;
+		return 1;
+	}
+
+	const char* colorNames[]{ "Red", "Green", "Blue" };
+	const char* sizeNames[]{ "Small", "Medium", "Large" };
+	std::mt19937_64 rng{ 42 };
+	std::string line;
+	ofs << "name,color,size\n";
+	for (uint64_t i{ 0 }; i < rows; ++i) {
+		uint64_t random = rng();
+		line = "Controller ";
+		line += std::to_string(i);
+		line += ',';
+		line += colorNames[random % 3];
+		line += ',';
+		line += sizeNames[(random >> 8) % 3];
+		line += '\n';
+		ofs << line;
+	}
+	std::cout << "Wrote " << rows << " rows to " << filename << std::endl;
+	return 0;
+}
+
+int filter(const char* filename, int threads, size_t batchSize) {
+	ProductCatalog catalog{ filename };
+	ColorSpecification red{ Color::Red };
+	SizeSpecification small{ Size::Small };
+	auto redAndSmall = red && small;
+
+	// The callback runs on the worker threads, only touch atomics in there
+	std::atomic<uint64_t> nameBytes{ 0 };
+	auto start = std::chrono::steady_clock::now();
+	CatalogStats stats = catalog.filter(redAndSmall, [&](const std::vector<Product*>& matches) {
+		uint64_t bytes{ 0 };
+		for (const Product* product : matches) bytes += product->name.size();
+		nameBytes += bytes;
+	}, threads, batchSize);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << catalog.sizeInBytes() / (1024.0 * 1024.0) << " MB, " << stats.rows << " rows (" << stats.invalidRows << " invalid), "
+		<< stats.matches << " red and small\n"
+		<< seconds << " s, " << stats.rows / seconds << " rows/s, " << catalog.sizeInBytes() / seconds / (1024.0 * 1024.0) << " MB/s\n"
+		<< "Peak RSS " << peakResidentMegabytes() << " MB" << std::endl;
+	return 0;
+}
+
+int usage() {
+	std::cerr << "Usage: CatalogTool generate <file> [rows] | CatalogTool filter <file> [threads] [batch size]" << std::endl;
+	return 1;
+}
+
+int main(int argc, char* argv[]) {
+	try {
+		if (argc > 2 && std::strcmp(argv[1], "generate") == 0) {
+			uint64_t rows{ 10000000 };
+			if (argc > 3 && !parsePositive(argv[3], rows)) {
+				std::cerr << "Error: the row count has to be a positive integer" << std::endl;
+				return usage();
+			}
+			return generate(argv[2], rows);
+		}
+		if (argc > 2 && std::strcmp(argv[1], "filter") == 0) {
+			int threads = (argc > 3) ? std::atoi(argv[3]) : 0;
+			size_t batchSize{ ProductCatalog::defaultBatchSize };
+			if (argc > 4 && !parsePositive(argv[4], batchSize)) {
+				std::cerr << "Error: the batch size has to be a positive integer" << std::endl;
+				return usage();
+			}
+			return filter(argv[2], threads, batchSize);
+		}
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return usage();
+}
@@ -0,0 +1,289 @@
+/*
+Product catalog loader for the specification filters, for catalogs way bigger than memory.
+
+The catalog is a CSV with one "name,color,size" row per line (an optional "name,color,size" header is skipped), e.g.
+	Controller 1,Red,Small
+
+The file is memory mapped instead of read, and split in one chunk per thread. The split points are moved forward to the
+next line start, so every row belongs to exactly one chunk. Each thread parses its rows into a fixed size batch of
+Products that it reuses: the color and size are compared as string_views against the enum names (no strings built),
+and names are assigned into the Products already in the batch, so once a batch has been filled nothing gets allocated.
+Every full batch is run through the specification, the matches are handed to a callback and the batch is reused.
+
+Memory stays bounded no matter the file size: the batches are fixed, and the pages of the mapping a thread is done with are
+dropped with madvise, so they don't pile up in the resident set (the OS would reclaim them anyway, but peak RSS shows
+them until it does).
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ProductFilter.h"
+
+
+inline bool parseColor(std::string_view text, Color& color) {
+	if (text == "Red") color = Color::Red;
+	else if (text == "Green") color = Color::Green;
+	else if (text == "Blue") color = Color::Blue;
+	else return false;
+	return true;
+}
+
+inline bool parseSize(std::string_view text, Size& size) {
+	if (text == "Small") size = Size::Small;
+	else if (text == "Medium") size = Size::Medium;
+	else if (text == "Large") size = Size::Large;
+	else return false;
+	return true;
+}
+
+// Read only view of a whole file. Moveable, not copyable
+class MappedFile {
+public:
+	explicit MappedFile(const std::string& filename) {
+#ifdef _WIN32
+		file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Can't open " + filename);
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize)) {
+			CloseHandle(file);
+			throw std::runtime_error("Can't read " + filename);
+		}
+		size = static_cast<size_t>(fileSize.QuadPart);
+		if (size > 0) {
+			mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!mapping) {
+				CloseHandle(file);
+				throw std::runtime_error("Can't map " + filename);
+			}
+			data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		}
+#else
+		int descriptor = open(filename.c_str(), O_RDONLY);
+		if (descriptor < 0) throw std::runtime_error("Can't open " + filename);
+		struct stat status;
+		if (fstat(descriptor, &status) != 0) {
+			close(descriptor);
+			throw std::runtime_error("Can't read " + filename);
+		}
+		size = static_cast<size_t>(status.st_size);
+		if (size > 0) {
+			void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if (mapped == MAP_FAILED) {
+				close(descriptor);
+				throw std::runtime_error("Can't map " + filename);
+			}
+			data = static_cast<const char*>(mapped);
+			madvise(mapped, size, MADV_SEQUENTIAL); // Read ahead more, and drop pages behind sooner
+		}
+		close(descriptor); // The mapping keeps the file alive
+#endif
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept {
+		*this = std::move(other);
+	}
+
+	MappedFile& operator=(MappedFile&& other) noexcept {
+		if (this != &other) {
+			unmap();
+			std::swap(data, other.data);
+			std::swap(size, other.size);
+#ifdef _WIN32
+			std::swap(file, other.file);
+			std::swap(mapping, other.mapping);
+#endif
+		}
+		return *this;
+	}
+
+	~MappedFile() {
+		unmap();
+	}
+
+	const char* getData() const { return data; }
+	size_t getSize() const { return size; }
+
+	// Lets the OS drop the pages fully inside [first, last), they are read again from the file if touched later
+	void release(const char* first, const char* last) const {
+#ifndef _WIN32
+		const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+		uintptr_t begin = (reinterpret_cast<uintptr_t>(first) + pageSize - 1) & ~(pageSize - 1);
+		uintptr_t end = reinterpret_cast<uintptr_t>(last) & ~(pageSize - 1);
+		if (end > begin) madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+#else
+		(void)first;
+		(void)last; // Windows trims the working set of a read only view on its own
+#endif
+	}
+
+private:
+	const char* data{ nullptr };
+	size_t size{ 0 };
+#ifdef _WIN32
+	HANDLE file{ INVALID_HANDLE_VALUE };
+	HANDLE mapping{ nullptr };
+#endif
+
+	void unmap() {
+#ifdef _WIN32
+		if (data) UnmapViewOfFile(data);
+		if (mapping) CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+		file = INVALID_HANDLE_VALUE;
+		mapping = nullptr;
+#else
+		if (data) munmap(const_cast<char*>(data), size);
+#endif
+		data = nullptr;
+		size = 0;
+	}
+};
+
+struct CatalogStats {
+	uint64_t rows{ 0 }; // Valid rows, the ones that went through the specification
+	uint64_t matches{ 0 };
+	uint64_t invalidRows{ 0 }; // Unknown color/size or missing fields
+};
+
+class ProductCatalog {
+public:
+	static constexpr size_t defaultBatchSize{ 4096 };
+	static constexpr size_t releaseEvery{ 8 << 20 }; // Bytes parsed by a thread between madvise calls
+
+	explicit ProductCatalog(const std::string& filename)
+		: file{ filename } {}
+
+	size_t sizeInBytes() const { return file.getSize(); }
+
+	/*
+		Runs every row through `spec`. `onMatches(const std::vector<Product*>&)` gets the matches of each batch, it is called
+		from the worker threads (one batch at a time per thread, but different threads at the same time) and the Products
+		are only valid during the call. The specification is shared by the threads, isSatisfied must not change it.
+	*/
+	template <typename OnMatches>
+	CatalogStats filter(Specification<Product>& spec, OnMatches&& onMatches, int threadCount = 0, size_t batchSize = defaultBatchSize) const {
+		if (threadCount <= 0) threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+		if (batchSize == 0) batchSize = 1;
+
+		// Chunk boundaries moved to the start of the next line
+		const char* begin = file.getData();
+		const char* end = begin + file.getSize();
+		std::vector<const char*> bounds{ begin };
+		for (int t{ 1 }; t < threadCount; ++t) {
+			const char* bound = std::max(bounds.back(), begin + file.getSize() * t / threadCount);
+			const char* newline = (bound < end) ? static_cast<const char*>(std::memchr(bound, '\n', end - bound)) : nullptr;
+			bounds.push_back(newline ? newline + 1 : end);
+		}
+		bounds.push_back(end);
+
+		std::vector<CatalogStats> threadStats(threadCount);
+		std::vector<std::thread> workers;
+		for (int t{ 1 }; t < threadCount; ++t)
+			workers.emplace_back([&, t] { threadStats[t] = filterChunk(bounds[t], bounds[t + 1], spec, onMatches, batchSize); });
+		threadStats[0] = filterChunk(bounds[0], bounds[1], spec, onMatches, batchSize);
+		for (std::thread& worker : workers) worker.join();
+
+		CatalogStats total;
+		for (const CatalogStats& stats : threadStats) {
+			total.rows += stats.rows;
+			total.matches += stats.matches;
+			total.invalidRows += stats.invalidRows;
+		}
+		return total;
+	}
+
+	// Only counts the matches
+	CatalogStats filter(Specification<Product>& spec, int threadCount = 0, size_t batchSize = defaultBatchSize) const {
+		return filter(spec, [](const std::vector<Product*>&) {}, threadCount, batchSize);
+	}
+
+private:
+	MappedFile file;
+
+	template <typename OnMatches>
+	CatalogStats filterChunk(const char* first, const char* last, Specification<Product>& spec, OnMatches& onMatches, size_t batchSize) const {
+		CatalogStats stats;
+		std::vector<Product> batch;
+		batch.reserve(batchSize);
+		std::vector<Product*> matches;
+		matches.reserve(batchSize);
+		size_t filled{ 0 };
+
+		auto flush = [&] {
+			matches.clear();
+			for (size_t i{ 0 }; i < filled; ++i) {
+				if (spec.isSatisfied(&batch[i])) matches.push_back(&batch[i]);
+			}
+			stats.matches += matches.size();
+			if (!matches.empty()) onMatches(matches);
+			filled = 0;
+		};
+
+		const char* released = first;
+		const char* line = first;
+		while (line < last) {
+			const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', last - line));
+			if (!lineEnd) lineEnd = last;
+			std::string_view row{ line, static_cast<size_t>(lineEnd - line) };
+			line = lineEnd + 1;
+
+			if (!row.empty() && row.back() == '\r') row.remove_suffix(1);
+			if (row.empty() || row == "name,color,size") continue;
+
+			// name,color,size: the name is everything before the second to last comma, so names can have commas
+			size_t sizeComma = row.rfind(',');
+			size_t colorComma = (sizeComma == std::string_view::npos || sizeComma == 0) ? std::string_view::npos : row.rfind(',', sizeComma - 1);
+			Color color;
+			Size size;
+			if (colorComma == std::string_view::npos
+				|| !parseColor(row.substr(colorComma + 1, sizeComma - colorComma - 1), color)
+				|| !parseSize(row.substr(sizeComma + 1), size)) {
+				++stats.invalidRows;
+				continue;
+			}
+
+			// Products in the batch are reused, assign keeps the name's buffer
+			if (filled == batch.size()) batch.emplace_back("", color, size);
+			Product& product = batch[filled++];
+			product.name.assign(row.data(), colorComma);
+			product.color = color;
+			product.size = size;
+			++stats.rows;
+
+			if (filled == batchSize) {
+				flush();
+				if (line - released >= static_cast<std::ptrdiff_t>(releaseEvery)) {
+					file.release(released, std::min(line, last));
+					released = std::min(line, last);
+				}
+			}
+		}
+		if (filled > 0) flush();
+		file.release(released, last);
+		return stats;
+	}
+};
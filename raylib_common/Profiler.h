@@ -0,0 +1,280 @@
+/*
+	Lightweight frame profiler shared by the raylib games (no raylib in here, see ProfilerOverlay.h for the drawing part).
+
+	Wrap a phase with PROFILE_SCOPE("name") and call Profiler::endFrame() once per frame from the game loop thread.
+	Every scope is stored as an event in a ring buffer owned by the thread that ran it, so recording never takes a lock.
+	endFrame() adds up what every thread spent in each phase since the last call (so a simulation thread ticking on its
+	own shows up next to the render thread, its ticks counted in the frame they finished in) and keeps the last
+	`historyFrames` totals per phase, which is what the p50/p99 come from. Profiler::dumpChromeTrace() writes every event still in the
+	ring buffers as Chrome trace JSON (open it in chrome://tracing or https://ui.perfetto.dev).
+
+	The scopes compile to nothing unless PROFILER_ENABLED is defined before including this header, so headless simulations
+	and benchmarks don't pay for them. Defining PROFILER_USE_RDTSC reads the time stamp counter instead of steady_clock.
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef PROFILER_USE_RDTSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+class Profiler {
+public:
+	static constexpr size_t eventsPerThread{ 1 << 16 }; // Power of two, so the ring index is a mask
+	static constexpr size_t historyFrames{ 240 };
+
+	struct Event {
+		const char* name; // Has to outlive the profiler, string literals are what PROFILE_SCOPE is meant for
+		uint64_t start, end; // Ticks, see ticksToNanoseconds
+	};
+
+	struct PhaseSummary {
+		const char* name;
+		double lastMs, p50Ms, p99Ms;
+	};
+
+	static uint64_t now() {
+#ifdef PROFILER_USE_RDTSC
+		return __rdtsc();
+#else
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+	static double ticksToNanoseconds(uint64_t ticks) {
+#ifdef PROFILER_USE_RDTSC
+		return ticks * nanosecondsPerTick();
+#else
+		return static_cast<double>(ticks);
+#endif
+	}
+
+	static void record(const char* name, uint64_t start, uint64_t end) {
+		ThreadEvents& events = threadEvents();
+		uint64_t head = events.head.load(std::memory_order_relaxed);
+		// Pairs with the fence in copyEvents: a reader that sees any part of this slot sees head at least where it is now
+		std::atomic_thread_fence(std::memory_order_release);
+		events.ring[head & (eventsPerThread - 1)].store({ name, start, end });
+		events.head.store(head + 1, std::memory_order_release);
+	}
+
+	// Call once per frame from the thread running the game loop, it takes the events of the other threads too
+	static void endFrame() {
+		std::lock_guard<std::mutex> lock{ state().mutex };
+		std::vector<Phase>& phases = state().phases;
+		for (Phase& phase : phases)
+			phase.frameNanoseconds = 0;
+
+		std::vector<Event>& events = state().scratch;
+		for (const auto& thread : state().threads) {
+			events.clear();
+			thread->aggregatedUntil = copyEvents(*thread, thread->aggregatedUntil, events);
+			for (const Event& event : events)
+				findOrAddPhase(phases, event.name).frameNanoseconds += ticksToNanoseconds(event.end - event.start);
+		}
+
+		for (Phase& phase : phases) {
+			phase.historyMs[phase.next] = static_cast<float>(phase.frameNanoseconds / 1e6);
+			phase.next = (phase.next + 1) % historyFrames;
+			phase.count = std::min(phase.count + 1, historyFrames);
+		}
+	}
+
+	// Per phase time spent in the last frame and percentiles over the last `historyFrames` frames
+	static std::vector<PhaseSummary> summarize() {
+		std::lock_guard<std::mutex> lock{ state().mutex };
+		std::vector<PhaseSummary> summaries;
+		std::vector<float> sorted;
+
+		for (const Phase& phase : state().phases) {
+			if (phase.count == 0) continue;
+			sorted.assign(phase.historyMs.begin(), phase.historyMs.begin() + phase.count);
+			std::sort(sorted.begin(), sorted.end());
+			size_t last = (phase.next + historyFrames - 1) % historyFrames;
+			summaries.push_back({ phase.name, phase.historyMs[last], sorted[(sorted.size() - 1) / 2], sorted[(sorted.size() - 1) * 99 / 100] });
+		}
+		return summaries;
+	}
+
+	// Writes every event still in the ring buffers of every thread. Returns false if the file couldn't be written
+	static bool dumpChromeTrace(const std::string& filename) {
+		std::ofstream ofs{ filename };
+		if (!ofs) return false;
+
+		std::lock_guard<std::mutex> lock{ state().mutex };
+
+		// Other threads can keep recording while this runs, copyEvents leaves out whatever they overwrote meanwhile
+		std::vector<std::pair<uint32_t, Event>> events;
+		std::vector<Event>& copied = state().scratch;
+		for (const auto& thread : state().threads) {
+			copied.clear();
+			copyEvents(*thread, 0, copied);
+			for (const Event& event : copied)
+				events.emplace_back(thread->threadId, event);
+		}
+
+		// Timestamps are written relative to the oldest event, the viewers don't like huge numbers
+		uint64_t epoch = events.empty() ? 0 : events.front().second.start;
+		for (const auto& [threadId, event] : events)
+			epoch = std::min(epoch, event.start);
+
+		ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool first{ true };
+		for (const auto& [threadId, event] : events) {
+			ofs << (first ? "" : ",") << "\n{\"name\":\"" << event.name << "\",\"cat\":\"phase\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId
+				<< ",\"ts\":" << ticksToNanoseconds(event.start - epoch) / 1000.0
+				<< ",\"dur\":" << ticksToNanoseconds(event.end - event.start) / 1000.0 << "}";
+			first = false;
+		}
+		ofs << "\n]}\n";
+		return static_cast<bool>(ofs);
+	}
+
+private:
+	// One ring entry. The fields are atomics (relaxed, plain moves on x86) because other threads copy them while the
+	// owner may be writing the slot again, copyEvents throws those copies away
+	struct Slot {
+		std::atomic<const char*> name{ nullptr };
+		std::atomic<uint64_t> start{ 0 }, end{ 0 };
+
+		void store(const Event& event) {
+			name.store(event.name, std::memory_order_relaxed);
+			start.store(event.start, std::memory_order_relaxed);
+			end.store(event.end, std::memory_order_relaxed);
+		}
+
+		Event load() const {
+			return { name.load(std::memory_order_relaxed), start.load(std::memory_order_relaxed), end.load(std::memory_order_relaxed) };
+		}
+	};
+
+	struct ThreadEvents {
+		std::vector<Slot> ring;
+		std::atomic<uint64_t> head{ 0 };
+		uint64_t aggregatedUntil{ 0 }; // Only touched in endFrame, under the lock
+		uint32_t threadId;
+
+		explicit ThreadEvents(uint32_t threadId)
+			: ring(eventsPerThread), threadId{ threadId } {}
+	};
+
+	struct Phase {
+		const char* name;
+		double frameNanoseconds{ 0 };
+		std::vector<float> historyMs = std::vector<float>(historyFrames, 0.0f);
+		size_t next{ 0 };
+		size_t count{ 0 };
+	};
+
+	struct State {
+		std::mutex mutex;
+		std::vector<std::shared_ptr<ThreadEvents>> threads; // Shared, so the events of a thread that finished can still be dumped
+		std::vector<Phase> phases;
+		std::vector<Event> scratch; // Copies of one thread's events, kept so endFrame doesn't allocate every frame
+	};
+
+	static State& state() {
+		static State instance;
+		return instance;
+	}
+
+	static ThreadEvents& threadEvents() {
+		// Registering takes the lock, but only the first time a thread records something
+		thread_local std::shared_ptr<ThreadEvents> events = [] {
+			std::lock_guard<std::mutex> lock{ state().mutex };
+			auto created = std::make_shared<ThreadEvents>(static_cast<uint32_t>(state().threads.size() + 1));
+			state().threads.push_back(created);
+			return created;
+		}();
+		return *events;
+	}
+
+	/*
+		Appends the events of `thread` from number `from` (or the oldest one still in the ring) up to its head and returns
+		that head. The owner keeps recording meanwhile, so the head is read again after copying: slot i is written again
+		for event i + eventsPerThread, which can already be in progress when head is i + eventsPerThread, so every copied
+		event at or before newHead - eventsPerThread is dropped.
+	*/
+	static uint64_t copyEvents(const ThreadEvents& thread, uint64_t from, std::vector<Event>& events) {
+		uint64_t head = thread.head.load(std::memory_order_acquire);
+		uint64_t first = std::max(from, head > eventsPerThread ? head - eventsPerThread : 0);
+		size_t begin = events.size();
+		for (uint64_t i{ first }; i < head; ++i)
+			events.push_back(thread.ring[i & (eventsPerThread - 1)].load());
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		uint64_t headAfter = thread.head.load(std::memory_order_relaxed);
+		uint64_t firstIntact = headAfter >= eventsPerThread ? headAfter - eventsPerThread + 1 : 0;
+		if (firstIntact > first) {
+			uint64_t overwritten = std::min(firstIntact, head) - first;
+			events.erase(events.begin() + begin, events.begin() + begin + static_cast<ptrdiff_t>(overwritten));
+		}
+		return head;
+	}
+
+	static Phase& findOrAddPhase(std::vector<Phase>& phases, const char* name) {
+		for (Phase& phase : phases) {
+			if (phase.name == name || std::strcmp(phase.name, name) == 0) return phase;
+		}
+		phases.push_back(Phase{ name });
+		return phases.back();
+	}
+
+#ifdef PROFILER_USE_RDTSC
+	// The counter runs at a fixed rate, measure it once against steady_clock
+	static double nanosecondsPerTick() {
+		static const double ratio = [] {
+			auto clockStart = std::chrono::steady_clock::now();
+			uint64_t ticksStart = __rdtsc();
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			uint64_t ticks = __rdtsc() - ticksStart;
+			double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - clockStart).count());
+			return nanoseconds / ticks;
+		}();
+		return ratio;
+	}
+#endif
+};
+
+class ScopedTimer {
+public:
+	explicit ScopedTimer(const char* name)
+		: name{ name }, start{ Profiler::now() } {}
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	~ScopedTimer() {
+		Profiler::record(name, start, Profiler::now());
+	}
+
+private:
+	const char* name;
+	uint64_t start;
+};
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+#ifdef PROFILER_ENABLED
+#define PROFILE_SCOPE(name) ScopedTimer PROFILER_CONCAT(profileScope, __LINE__){ name }
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
@@ -0,0 +1,33 @@
+/*
+	On-screen table with the per phase numbers of Profiler::summarize(). Call it between BeginDrawing and EndDrawing.
+*/
+#pragma once
+
+namespace rl {
+	#include "raylib.h"
+}
+
+#include "Profiler.h"
+
+inline void drawProfilerOverlay(int x, int y) {
+	const int fontSize{ 10 };
+	const int lineHeight{ fontSize + 4 };
+	const int columns[]{ x + 6, x + 180, x + 230, x + 280 }; // The default font isn't monospaced, so columns go at fixed offsets
+	std::vector<Profiler::PhaseSummary> summaries = Profiler::summarize();
+
+	int height = lineHeight * static_cast<int>(summaries.size() + 1) + 8;
+	rl::DrawRectangle(x, y, 330, height, rl::Fade(rl::BLACK, 0.7f));
+	rl::DrawText("phase (ms)", columns[0], y + 4, fontSize, rl::GREEN);
+	rl::DrawText("last", columns[1], y + 4, fontSize, rl::GREEN);
+	rl::DrawText("p50", columns[2], y + 4, fontSize, rl::GREEN);
+	rl::DrawText("p99", columns[3], y + 4, fontSize, rl::GREEN);
+
+	int lineY = y + 4;
+	for (const auto& summary : summaries) {
+		lineY += lineHeight;
+		rl::DrawText(summary.name, columns[0], lineY, fontSize, rl::RAYWHITE);
+		rl::DrawText(rl::TextFormat("%.3f", summary.lastMs), columns[1], lineY, fontSize, rl::RAYWHITE);
+		rl::DrawText(rl::TextFormat("%.3f", summary.p50Ms), columns[2], lineY, fontSize, rl::RAYWHITE);
+		rl::DrawText(rl::TextFormat("%.3f", summary.p99Ms), columns[3], lineY, fontSize, rl::RAYWHITE);
+	}
+}
@@ -0,0 +1,86 @@
+/*
+	Cost of a MultiBallWorld step for a growing number of balls, with the grid broadphase and with the O(n^2) pairwise check.
+	The game area grows with the ball count so the density (and the contacts per ball) stays the same, which is what
+	makes the grid cost per ball flat.
+
+	Before timing, both broadphases look for contacts in the same state and have to find the same pairs.
+
+	Usage: MultiBallBenchmark [steps = 200] [max pairwise balls = 16000]
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../../common/CommandLine.h"
+#include "MultiBallWorld.h"
+
+double millisecondsPerStep(MultiBallWorld& world, int steps, float timeStep) {
+	auto start = std::chrono::steady_clock::now();
+	for (int s{ 0 }; s < steps; ++s)
+		world.step(timeStep);
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / steps;
+}
+
+int main(int argc, char* argv[]) {
+	int steps{ 200 };
+	if (argc > 1 && !parsePositive(argv[1], steps)) {
+		std::cerr << "Usage: MultiBallBenchmark [steps = 200] [max pairwise balls = 16000], steps has to be at least 1" << std::endl;
+		return 1;
+	}
+	int maxPairwiseBalls = (argc > 2) ? std::atoi(argv[2]) : 16000;
+
+	const float radius{ 3 };
+	const float areaPerBall{ 400 }; // About 7% of the area covered by balls
+	const float timeStep{ 1.0f / 120.0f };
+
+	std::cout << std::setw(8) << "balls" << std::setw(10) << "contacts" << std::setw(12) << "grid ms" << std::setw(14) << "grid ns/ball"
+		<< std::setw(14) << "pairwise ms" << std::setw(10) << "speedup" << "\n";
+
+	int mismatches{ 0 };
+	for (int count : { 250, 500, 1000, 2000, 4000, 8000, 16000, 32000, 64000 }) {
+		int side = static_cast<int>(std::sqrt(count * areaPerBall));
+		const PlayableRectangle gameArea{ 0, 0, side, side };
+		Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
+		Paddle rightPaddle{ 10, 100, Paddle::RIGHT, 500 };
+		leftPaddle.positionInPlayableArea(gameArea);
+		rightPaddle.positionInPlayableArea(gameArea);
+
+		MultiBallWorld grid{ gameArea, leftPaddle, rightPaddle, radius };
+		grid.spawnRandomBalls(count, radius, 100.0f, 300.0f, 7);
+		for (int s{ 0 }; s < 60; ++s) grid.step(timeStep); // Let the initial overlaps settle
+
+		// Same state through both broadphases, the grid reorders the pool so that goes first
+		MultiBallWorld pairwise{ grid };
+		bool timePairwise = count <= maxPairwiseBalls;
+		size_t contactCount = grid.findContacts();
+		if (timePairwise) {
+			pairwise.balls = grid.balls;
+			pairwise.broadphase = MultiBallWorld::Broadphase::PAIRWISE;
+			pairwise.findContacts();
+			std::vector<MultiBallWorld::Contact> a = grid.getContacts(), b = pairwise.getContacts();
+			std::sort(a.begin(), a.end());
+			std::sort(b.begin(), b.end());
+			if (a != b) {
+				std::cout << "Contacts differ for " << count << " balls: grid " << a.size() << ", pairwise " << b.size() << "\n";
+				++mismatches;
+			}
+		}
+
+		double gridMs = millisecondsPerStep(grid, steps, timeStep);
+		std::cout << std::setw(8) << count << std::setw(10) << contactCount << std::fixed << std::setprecision(3)
+			<< std::setw(12) << gridMs << std::setw(14) << std::setprecision(1) << gridMs * 1e6 / count;
+
+		if (timePairwise) {
+			// Fewer steps, it's the slow one
+			double pairwiseMs = millisecondsPerStep(pairwise, std::max(1, steps / 10), timeStep);
+			std::cout << std::setw(14) << std::setprecision(3) << pairwiseMs << std::setw(9) << std::setprecision(1) << pairwiseMs / gridMs << "x";
+		}
+		std::cout << std::endl;
+	}
+
+	return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+/*
+	Stress mode: thousands of balls in one game area, bouncing off the paddles, the walls and each other.
+
+	The balls live in one contiguous pool (a vector of Ball). Every step each ball is moved with the same swept collision
+	against paddles and walls as the single ball game, then ball vs ball contacts are found with a uniform grid:
+	cells are as wide as the biggest ball, so two touching balls are always in the same or in neighboring cells.
+	The grid is rebuilt from scratch every step with a counting sort by cell (count per cell, prefix sum, scatter), and
+	the pool itself is what gets sorted. After that a cell's balls are contiguous, and so are the three cells below it,
+	so a ball only has to be tested against two ranges of the pool: the rest of its own cell plus the cell to the right,
+	and the three cells below. That visits every close pair once and the cost grows with the number of balls instead of
+	its square, Broadphase::PAIRWISE is the O(n^2) version to compare against.
+
+	Contacts are solved as elastic collisions (mass goes with the area of the ball) and the overlap is split between the
+	two balls so they don't sink into each other.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../../raylib_common/Profiler.h"
+#include "PongCore.h"
+#include "SweptCollision.h"
+
+class MultiBallWorld {
+public:
+	enum class Broadphase { GRID, PAIRWISE };
+
+	struct Contact {
+		uint32_t a, b; // Indices in the pool, a < b
+
+		bool operator==(const Contact& other) const { return a == other.a && b == other.b; }
+		bool operator<(const Contact& other) const { return a < other.a || (a == other.a && b < other.b); }
+	};
+
+	std::vector<Ball> balls; // The pool, reordered by grid cell every step so don't keep indices across steps
+	Broadphase broadphase{ Broadphase::GRID };
+
+	MultiBallWorld(const PlayableRectangle& gameArea, const Paddle& leftPaddle, const Paddle& rightPaddle, float maxBallRadius)
+		: gameArea{ gameArea }, leftPaddle{ leftPaddle }, rightPaddle{ rightPaddle }, maxBallRadius{ maxBallRadius }, cellSize{ 2 * maxBallRadius },
+		  columns{ std::max(1, static_cast<int>(std::ceil(gameArea.dimentions.x / cellSize))) },
+		  rows{ std::max(1, static_cast<int>(std::ceil(gameArea.dimentions.y / cellSize))) },
+		  cellStart(static_cast<size_t>(columns) * rows + 1, 0) {}
+
+	void addBall(const Ball& ball) {
+		if (ball.radius > maxBallRadius) throw std::invalid_argument("MultiBallWorld: ball bigger than the grid was made for");
+		balls.push_back(ball);
+	}
+
+	// Balls at random positions going in random directions
+	void spawnRandomBalls(int count, float radius, float minSpeed, float maxSpeed, uint64_t seed) {
+		if (count < 0) throw std::invalid_argument("MultiBallWorld: negative ball count");
+		std::mt19937_64 rng{ seed };
+		std::uniform_real_distribution<float> x{ gameArea.origin.x + radius, gameArea.origin.x + gameArea.dimentions.x - radius };
+		std::uniform_real_distribution<float> y{ gameArea.origin.y + radius, gameArea.origin.y + gameArea.dimentions.y - radius };
+		std::uniform_real_distribution<float> angle{ 0.0f, 6.2831853f };
+		std::uniform_real_distribution<float> speed{ minSpeed, maxSpeed };
+
+		balls.reserve(balls.size() + count);
+		for (int i{ 0 }; i < count; ++i) {
+			float a = angle(rng), s = speed(rng);
+			Ball ball{ 0, s * std::cos(a), s * std::sin(a) };
+			ball.radius = radius;
+			ball.position = { x(rng), y(rng) };
+			addBall(ball);
+		}
+	}
+
+	void step(float deltaTime) {
+		PROFILE_SCOPE("multiBallStep");
+		{
+			PROFILE_SCOPE("moveBalls");
+			for (Ball& ball : balls)
+				advanceBallSwept(ball, leftPaddle, rightPaddle, gameArea, deltaTime);
+		}
+		findContacts();
+		resolveContacts();
+	}
+
+	// Fills getContacts() with every pair of overlapping balls, sorting the pool by cell first when using the grid
+	size_t findContacts() {
+		PROFILE_SCOPE("findContacts");
+		contacts.clear();
+		if (broadphase == Broadphase::GRID) {
+			rebuildGrid();
+			findContactsInGrid();
+		}
+		else findContactsPairwise();
+		return contacts.size();
+	}
+
+	void resolveContacts() {
+		PROFILE_SCOPE("resolveContacts");
+		for (const Contact& contact : contacts)
+			collideBalls(balls[contact.a], balls[contact.b]);
+	}
+
+	const std::vector<Contact>& getContacts() const { return contacts; }
+	int getColumns() const { return columns; }
+	int getRows() const { return rows; }
+
+private:
+	const PlayableRectangle& gameArea;
+	const Paddle& leftPaddle;
+	const Paddle& rightPaddle;
+	float maxBallRadius, cellSize;
+	int columns, rows;
+
+	std::vector<uint32_t> cellStart; // Balls of cell c are balls[cellStart[c], cellStart[c + 1])
+	std::vector<uint32_t> cellOf, cursor;
+	std::vector<Ball> sorted; // Scatter target of the counting sort, swapped with the pool afterwards
+	std::vector<Contact> contacts;
+
+	int cellIndex(Vector2 position) const {
+		// Balls never leave the area, the clamp is only for rounding right at the edges
+		int x = std::clamp(static_cast<int>((position.x - gameArea.origin.x) / cellSize), 0, columns - 1);
+		int y = std::clamp(static_cast<int>((position.y - gameArea.origin.y) / cellSize), 0, rows - 1);
+		return y * columns + x;
+	}
+
+	void rebuildGrid() {
+		PROFILE_SCOPE("rebuildGrid");
+		const size_t cells = cellStart.size() - 1;
+		cellOf.resize(balls.size());
+		std::fill(cellStart.begin(), cellStart.end(), 0);
+
+		for (size_t i{ 0 }; i < balls.size(); ++i) {
+			cellOf[i] = static_cast<uint32_t>(cellIndex(balls[i].position));
+			++cellStart[cellOf[i] + 1];
+		}
+		for (size_t c{ 0 }; c < cells; ++c)
+			cellStart[c + 1] += cellStart[c];
+
+		cursor.assign(cellStart.begin(), cellStart.end() - 1);
+		sorted.resize(balls.size(), Ball{ 0 });
+		for (size_t i{ 0 }; i < balls.size(); ++i)
+			sorted[cursor[cellOf[i]]++] = balls[i];
+		std::swap(balls, sorted);
+	}
+
+	void testRange(uint32_t a, uint32_t first, uint32_t last) {
+		const Ball& ballA = balls[a];
+		for (uint32_t b{ first }; b < last; ++b) {
+			const Ball& ballB = balls[b];
+			float dx = ballB.position.x - ballA.position.x, dy = ballB.position.y - ballA.position.y;
+			float reach = ballA.radius + ballB.radius;
+			if (dx * dx + dy * dy < reach * reach) contacts.push_back({ a, b });
+		}
+	}
+
+	void findContactsInGrid() {
+		for (int y{ 0 }; y < rows; ++y) {
+			for (int x{ 0 }; x < columns; ++x) {
+				int cell = y * columns + x;
+				uint32_t sameRowEnd = cellStart[(x + 1 < columns) ? cell + 2 : cell + 1]; // End of this cell or of the one to the right
+				uint32_t belowFirst{ 0 }, belowLast{ 0 };
+				if (y + 1 < rows) {
+					belowFirst = cellStart[cell + columns - (x > 0 ? 1 : 0)];
+					belowLast = cellStart[cell + columns + (x + 1 < columns ? 2 : 1)];
+				}
+
+				for (uint32_t a{ cellStart[cell] }; a < cellStart[cell + 1]; ++a) {
+					testRange(a, a + 1, sameRowEnd);
+					testRange(a, belowFirst, belowLast);
+				}
+			}
+		}
+	}
+
+	void findContactsPairwise() {
+		const uint32_t count = static_cast<uint32_t>(balls.size());
+		for (uint32_t a{ 0 }; a < count; ++a)
+			testRange(a, a + 1, count);
+	}
+
+	static void collideBalls(Ball& a, Ball& b) {
+		float dx = b.position.x - a.position.x, dy = b.position.y - a.position.y;
+		float distance = std::sqrt(dx * dx + dy * dy);
+		Vector2 normal = (distance > 0) ? Vector2{ dx / distance, dy / distance } : Vector2{ 1, 0 }; // From a to b
+
+		float inverseMassA = 1.0f / (a.radius * a.radius), inverseMassB = 1.0f / (b.radius * b.radius);
+		float share = inverseMassA / (inverseMassA + inverseMassB);
+
+		// Push them apart, the lighter ball moves more
+		float overlap = a.radius + b.radius - distance;
+		a.position.x -= normal.x * overlap * share;
+		a.position.y -= normal.y * overlap * share;
+		b.position.x += normal.x * overlap * (1 - share);
+		b.position.y += normal.y * overlap * (1 - share);
+
+		// Elastic impulse along the normal, only if they are getting closer
+		float approach = (b.speed.x - a.speed.x) * normal.x + (b.speed.y - a.speed.y) * normal.y;
+		if (approach >= 0) return;
+		float impulse = -2 * approach / (inverseMassA + inverseMassB);
+		a.speed.x -= impulse * inverseMassA * normal.x;
+		a.speed.y -= impulse * inverseMassA * normal.y;
+		b.speed.x += impulse * inverseMassB * normal.x;
+		b.speed.y += impulse * inverseMassB * normal.y;
+	}
+};
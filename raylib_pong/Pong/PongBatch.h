@@ -0,0 +1,531 @@
+/*
+	Batch of Pong matches stored as a struct of arrays, so thousands of matches can be stepped at once (AI evaluation).
+
+	Every match shares the same game area, ball radius and paddle geometry, what changes per match is the state: ball position
+	and speed, paddle heights and paddle inputs. Each one of those lives in its own array so the update kernel can process
+	4 matches per instruction with SSE. The update follows the exact same order as PongGameHeadless::update, so a batch and a
+	vector of PongGame objects started from the same state end up in the same state.
+
+	Collisions are swept like in PongGameHeadless (continuousCollisions, on by default in both): the scalar kernel calls
+	advanceCircleSwept from SweptCollision.h and the SSE one does the same operations on 4 lanes, every lane looping until
+	its own step is used up, so a fast ball can't go through a paddle here either.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+#if (defined(__SSE2__) || defined(_M_X64)) && !defined(PONG_BATCH_NO_SSE) // Define it to try the scalar kernel
+#include <emmintrin.h>
+#define PONG_BATCH_SSE 1
+#endif
+
+#include "../../common/WorkerThreads.h"
+#include "PongCore.h"
+#include "SweptCollision.h"
+
+// std::allocator only lines the floats up to 16 bytes, this one puts the first element at the start of a cache line
+template <typename T, size_t Alignment>
+struct AlignedAllocator {
+	using value_type = T;
+
+	template <typename U>
+	struct rebind {
+		using other = AlignedAllocator<U, Alignment>;
+	};
+
+	AlignedAllocator() = default;
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+	T* allocate(size_t count) {
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{ Alignment }));
+	}
+
+	void deallocate(T* pointer, size_t) {
+		::operator delete(pointer, std::align_val_t{ Alignment });
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+	template <typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+class PongBatch {
+public:
+	// Matches are handed to threads in multiples of this: 16 floats = one 64 byte cache line, and every array starts on
+	// a line (AlignedAllocator), so no two threads write the same line
+	static constexpr int matchesPerCacheLine{ 16 };
+	// All steps are run on a block before moving to the next one, so the block stays in cache for the whole call
+	static constexpr int matchesPerBlock{ 2048 };
+
+	using Floats = std::vector<float, AlignedAllocator<float, 64>>;
+
+	Floats ballX, ballY, ballSpeedX, ballSpeedY;
+	Floats leftPaddleY, rightPaddleY;
+	Floats leftInput, rightInput; // -1 up, 0 idle, 1 down
+	bool continuousCollisions{ true }; // False is the end of step overlap test, like PongGameHeadless
+
+	PongBatch(int matchCount, const PlayableRectangle& gameArea, const Ball& ballTemplate, const Paddle& paddleTemplate)
+		: matchCount{ matchCount } {
+		Ball ball{ ballTemplate };
+		Paddle leftPaddle{ paddleTemplate };
+		Paddle rightPaddle{ paddleTemplate };
+		leftPaddle.type = Paddle::LEFT;
+		rightPaddle.type = Paddle::RIGHT;
+
+		// Let the objects position themselves, that way the batch starts exactly where PongGame::initialize() would
+		ball.positionInPlayableArea(gameArea);
+		leftPaddle.positionInPlayableArea(gameArea);
+		rightPaddle.positionInPlayableArea(gameArea);
+
+		radius = ball.radius;
+		paddleSpeed = std::fabs(paddleTemplate.speed.y);
+		paddleHeight = paddleTemplate.height;
+		paddleHalfWidth = paddleTemplate.width / 2;
+		paddleHalfHeight = paddleTemplate.height / 2;
+		leftPaddleX = leftPaddle.position.x;
+		rightPaddleX = rightPaddle.position.x;
+		leftContactX = leftPaddleX + paddleHalfWidth + radius;
+		rightContactX = rightPaddleX - paddleHalfWidth - radius;
+		areaLeft = gameArea.origin.x;
+		areaRight = gameArea.origin.x + gameArea.dimentions.x;
+		areaTop = gameArea.origin.y;
+		areaBottom = gameArea.origin.y + gameArea.dimentions.y;
+		ballBounds = { areaLeft + radius, areaRight - radius, areaTop + radius, areaBottom - radius };
+
+		// Padding up to a full cache line means the kernels never need a scalar tail
+		int paddedCount = (matchCount + matchesPerCacheLine - 1) / matchesPerCacheLine * matchesPerCacheLine;
+		ballX.assign(paddedCount, ball.position.x);
+		ballY.assign(paddedCount, ball.position.y);
+		ballSpeedX.assign(paddedCount, ball.speed.x);
+		ballSpeedY.assign(paddedCount, ball.speed.y);
+		leftPaddleY.assign(paddedCount, leftPaddle.position.y);
+		rightPaddleY.assign(paddedCount, rightPaddle.position.y);
+		leftInput.assign(paddedCount, 0.0f);
+		rightInput.assign(paddedCount, 0.0f);
+	}
+
+	int size() const {
+		return matchCount;
+	}
+
+	void setBallSpeed(int match, float speedX, float speedY) {
+		ballSpeedX[match] = speedX;
+		ballSpeedY[match] = speedY;
+	}
+
+	void setInputs(int match, int left, int right) {
+		leftInput[match] = static_cast<float>(left);
+		rightInput[match] = static_cast<float>(right);
+	}
+
+	/*
+		Runs `steps` updates of every match. Inputs are held for the whole call, call it with steps = 1 to change them every step.
+		With threadCount > 1 the calling thread takes the first part of the matches and threadCount - 1 worker threads the
+		rest. The workers are started on the first threaded call and kept waiting between calls (they're only started again
+		if threadCount changes), so stepping one step per call costs a wake up per worker, not a thread start.
+	*/
+	void step(float timeStep, int steps = 1, int threadCount = 1) {
+		int paddedCount = static_cast<int>(ballX.size());
+		int lines = paddedCount / matchesPerCacheLine;
+		threadCount = std::max(1, std::min(threadCount, lines));
+
+		if (threadCount == 1) {
+			stepRange(0, paddedCount, timeStep, steps);
+			return;
+		}
+
+		auto range = [=](int t) {
+			int begin = static_cast<int>(static_cast<long long>(lines) * t / threadCount) * matchesPerCacheLine;
+			int end = static_cast<int>(static_cast<long long>(lines) * (t + 1) / threadCount) * matchesPerCacheLine;
+			stepRange(begin, end, timeStep, steps);
+		};
+
+		const unsigned workerCount = static_cast<unsigned>(threadCount - 1);
+		if (!workers || workers->size() != workerCount) workers = std::make_unique<WorkerThreads>(workerCount);
+		std::function<void(unsigned)> workerJob = [&](unsigned worker) { range(static_cast<int>(worker) + 1); };
+		workers->start(workerJob);
+		range(0);
+		workers->wait();
+	}
+
+private:
+	int matchCount;
+
+	float radius;
+	float paddleSpeed, paddleHeight, paddleHalfWidth, paddleHalfHeight;
+	float leftPaddleX, rightPaddleX, leftContactX, rightContactX;
+	float areaLeft, areaRight, areaTop, areaBottom;
+	SweepBounds ballBounds;
+
+	std::unique_ptr<WorkerThreads> workers; // Only once step() has been called with more than one thread
+
+	void stepRange(int begin, int end, float timeStep, int steps) {
+		for (int blockBegin{ begin }; blockBegin < end; blockBegin += matchesPerBlock) {
+			int blockEnd = std::min(blockBegin + matchesPerBlock, end);
+			for (int s{ 0 }; s < steps; ++s) {
+#ifdef PONG_BATCH_SSE
+				stepBlockSSE(blockBegin, blockEnd, timeStep);
+#else
+				stepBlockScalar(blockBegin, blockEnd, timeStep);
+#endif
+			}
+		}
+	}
+
+	// Reference version of the kernel, it is what the SSE one does one lane at a time
+	void stepBlockScalar(int begin, int end, float timeStep) {
+		for (int i{ begin }; i < end; ++i) {
+			float x = ballX[i], y = ballY[i], speedX = ballSpeedX[i], speedY = ballSpeedY[i];
+			float leftY = leftPaddleY[i], rightY = rightPaddleY[i];
+
+			// Update positions, the swept ball moves during the collitions
+			if (!continuousCollisions) {
+				x += speedX * timeStep;
+				y += speedY * timeStep;
+			}
+			leftY += leftInput[i] * paddleSpeed * timeStep;
+			rightY += rightInput[i] * paddleSpeed * timeStep;
+
+			// Ball-paddle collitions
+			if (continuousCollisions) {
+				Vector2 position{ x, y }, speed{ speedX, speedY };
+				advanceCircleSwept(position, speed, radius, paddleBox(leftPaddleX, leftY), paddleBox(rightPaddleX, rightY), ballBounds, timeStep);
+				x = position.x; y = position.y; speedX = speed.x; speedY = speed.y;
+			}
+			else {
+				if (hitsPaddle(x, y, leftPaddleX, leftY)) {
+					x = leftContactX;
+					speedX = -speedX;
+					speedY = 500 * (y - leftY) / paddleHeight / 2;
+				}
+				if (hitsPaddle(x, y, rightPaddleX, rightY)) {
+					x = rightContactX;
+					speedX = -speedX;
+					speedY = 500 * (y - rightY) / paddleHeight / 2;
+				}
+			}
+
+			// Constrain to the game area
+			if (x - radius < areaLeft) { x = areaLeft + radius; speedX = -speedX; }
+			if (x + radius > areaRight) { x = areaRight - radius; speedX = -speedX; }
+			if (y - radius < areaTop) { y = areaTop + radius; speedY = -speedY; }
+			if (y + radius > areaBottom) { y = areaBottom - radius; speedY = -speedY; }
+			if (leftY - paddleHalfHeight < areaTop) leftY = areaTop + paddleHalfHeight;
+			if (leftY + paddleHalfHeight > areaBottom) leftY = areaBottom - paddleHalfHeight;
+			if (rightY - paddleHalfHeight < areaTop) rightY = areaTop + paddleHalfHeight;
+			if (rightY + paddleHalfHeight > areaBottom) rightY = areaBottom - paddleHalfHeight;
+
+			ballX[i] = x; ballY[i] = y; ballSpeedX[i] = speedX; ballSpeedY[i] = speedY;
+			leftPaddleY[i] = leftY; rightPaddleY[i] = rightY;
+		}
+	}
+
+	SweepBox paddleBox(float paddleX, float paddleY) const {
+		return { { paddleX, paddleY }, paddleHalfWidth, paddleHalfHeight, paddleHeight };
+	}
+
+	bool hitsPaddle(float x, float y, float paddleX, float paddleY) const {
+		float dx = std::fabs(x - paddleX);
+		float dy = std::fabs(y - paddleY);
+		if (dx > paddleHalfWidth + radius || dy > paddleHalfHeight + radius) return false;
+		if (dx <= paddleHalfWidth || dy <= paddleHalfHeight) return true;
+		float cornerDx = dx - paddleHalfWidth;
+		float cornerDy = dy - paddleHalfHeight;
+		return cornerDx * cornerDx + cornerDy * cornerDy <= radius * radius;
+	}
+
+#ifdef PONG_BATCH_SSE
+	// SSE2 has no blend instruction, so ifs become masks: lanes where mask is set take a, the rest keep b
+	static __m128 select(__m128 mask, __m128 a, __m128 b) {
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	__m128 hitsPaddleSSE(__m128 x, __m128 y, __m128 paddleX, __m128 paddleY) const {
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+		const __m128 halfWidth = _mm_set1_ps(paddleHalfWidth);
+		const __m128 halfHeight = _mm_set1_ps(paddleHalfHeight);
+		const __m128 r = _mm_set1_ps(radius);
+
+		__m128 dx = _mm_andnot_ps(signBit, _mm_sub_ps(x, paddleX));
+		__m128 dy = _mm_andnot_ps(signBit, _mm_sub_ps(y, paddleY));
+		__m128 inReach = _mm_and_ps(_mm_cmple_ps(dx, _mm_add_ps(halfWidth, r)), _mm_cmple_ps(dy, _mm_add_ps(halfHeight, r)));
+		__m128 onSide = _mm_or_ps(_mm_cmple_ps(dx, halfWidth), _mm_cmple_ps(dy, halfHeight));
+		__m128 cornerDx = _mm_sub_ps(dx, halfWidth);
+		__m128 cornerDy = _mm_sub_ps(dy, halfHeight);
+		__m128 cornerDistance = _mm_add_ps(_mm_mul_ps(cornerDx, cornerDx), _mm_mul_ps(cornerDy, cornerDy));
+		__m128 onCorner = _mm_cmple_ps(cornerDistance, _mm_mul_ps(r, r));
+		return _mm_and_ps(inReach, _mm_or_ps(onSide, onCorner));
+	}
+
+	struct SweepLanes {
+		__m128 hit; // Mask
+		__m128 time, normalX, normalY;
+	};
+
+	/*
+		sweepCircleBox on 4 lanes, every branch becomes a mask. Each lane has to come out bit for bit like the scalar
+		version, so the operations are the same ones in the same order. std::min(a, b) is (b < a) ? b : a, which is
+		_mm_min_ps(b, a) (and the same for max), that only matters for -0 and 0 but it costs nothing.
+	*/
+	SweepLanes sweepPaddleSSE(__m128 x, __m128 y, __m128 motionX, __m128 motionY, __m128 paddleX, __m128 paddleY) const {
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+		const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), minusOne = _mm_set1_ps(-1.0f);
+		const __m128 r = _mm_set1_ps(radius);
+		const __m128 halfWidth = _mm_set1_ps(paddleHalfWidth), halfHeight = _mm_set1_ps(paddleHalfHeight);
+		const __m128 grownHalfWidth = _mm_set1_ps(paddleHalfWidth + radius), grownHalfHeight = _mm_set1_ps(paddleHalfHeight + radius);
+		auto absolute = [&](__m128 v) { return _mm_andnot_ps(signBit, v); };
+		auto negate = [&](__m128 v) { return _mm_xor_ps(v, signBit); };
+		auto sign = [&](__m128 negativeMask) { return select(negativeMask, minusOne, one); };
+
+		__m128 relativeX = _mm_sub_ps(x, paddleX), relativeY = _mm_sub_ps(y, paddleY);
+		__m128 enter = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+		__m128 exit = _mm_set1_ps(std::numeric_limits<float>::infinity());
+		__m128 normalX = zero, normalY = zero;
+
+		// Slab test, a lane that doesn't move on an axis only has to be inside that slab
+		__m128 stillX = _mm_cmpeq_ps(motionX, zero);
+		__m128 missed = _mm_and_ps(stillX, _mm_cmpgt_ps(absolute(relativeX), grownHalfWidth));
+		__m128 t1 = _mm_div_ps(_mm_sub_ps(negate(grownHalfWidth), relativeX), motionX);
+		__m128 t2 = _mm_div_ps(_mm_sub_ps(grownHalfWidth, relativeX), motionX);
+		__m128 nearT = _mm_min_ps(t2, t1), farT = _mm_max_ps(t2, t1);
+		__m128 entered = _mm_andnot_ps(stillX, _mm_cmpgt_ps(nearT, enter));
+		enter = select(entered, nearT, enter);
+		normalX = select(entered, sign(_mm_cmpgt_ps(motionX, zero)), normalX);
+		normalY = select(entered, zero, normalY);
+		exit = select(stillX, exit, _mm_min_ps(farT, exit));
+
+		__m128 stillY = _mm_cmpeq_ps(motionY, zero);
+		missed = _mm_or_ps(missed, _mm_and_ps(stillY, _mm_cmpgt_ps(absolute(relativeY), grownHalfHeight)));
+		t1 = _mm_div_ps(_mm_sub_ps(negate(grownHalfHeight), relativeY), motionY);
+		t2 = _mm_div_ps(_mm_sub_ps(grownHalfHeight, relativeY), motionY);
+		nearT = _mm_min_ps(t2, t1);
+		farT = _mm_max_ps(t2, t1);
+		entered = _mm_andnot_ps(stillY, _mm_cmpgt_ps(nearT, enter));
+		enter = select(entered, nearT, enter);
+		normalX = select(entered, zero, normalX);
+		normalY = select(entered, sign(_mm_cmpgt_ps(motionY, zero)), normalY);
+		exit = select(stillY, exit, _mm_min_ps(farT, exit));
+
+		missed = _mm_or_ps(missed, _mm_or_ps(_mm_cmpgt_ps(enter, exit), _mm_or_ps(_mm_cmplt_ps(exit, zero), _mm_cmpgt_ps(enter, one))));
+
+		__m128 time = _mm_max_ps(zero, enter);
+		__m128 pointX = _mm_add_ps(relativeX, _mm_mul_ps(motionX, time));
+		__m128 pointY = _mm_add_ps(relativeY, _mm_mul_ps(motionY, time));
+
+		// Flat sides, pushed out through the side with the least penetration if it started overlapping
+		__m128 flat = _mm_or_ps(_mm_cmple_ps(absolute(pointX), halfWidth), _mm_cmple_ps(absolute(pointY), halfHeight));
+		__m128 startedInside = _mm_cmplt_ps(enter, zero);
+		__m128 penetrationX = _mm_sub_ps(grownHalfWidth, absolute(relativeX));
+		__m128 penetrationY = _mm_sub_ps(grownHalfHeight, absolute(relativeY));
+		__m128 pushX = _mm_cmplt_ps(penetrationX, penetrationY);
+		normalX = select(startedInside, select(pushX, sign(_mm_cmplt_ps(relativeX, zero)), zero), normalX);
+		normalY = select(startedInside, select(pushX, zero, sign(_mm_cmplt_ps(relativeY, zero))), normalY);
+		__m128 approaching = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(motionX, normalX), _mm_mul_ps(motionY, normalY)), zero);
+		__m128 flatHit = _mm_and_ps(flat, approaching);
+
+		// Corner circle
+		__m128 mX = _mm_sub_ps(relativeX, select(_mm_cmplt_ps(pointX, zero), negate(halfWidth), halfWidth));
+		__m128 mY = _mm_sub_ps(relativeY, select(_mm_cmplt_ps(pointY, zero), negate(halfHeight), halfHeight));
+		__m128 a = _mm_add_ps(_mm_mul_ps(motionX, motionX), _mm_mul_ps(motionY, motionY));
+		__m128 b = _mm_add_ps(_mm_mul_ps(mX, motionX), _mm_mul_ps(mY, motionY));
+		__m128 mLengthSquared = _mm_add_ps(_mm_mul_ps(mX, mX), _mm_mul_ps(mY, mY));
+		__m128 c = _mm_sub_ps(mLengthSquared, _mm_mul_ps(r, r));
+		__m128 notTowards = _mm_cmpge_ps(b, zero);
+
+		__m128 insideCorner = _mm_cmple_ps(c, zero);
+		__m128 length = _mm_sqrt_ps(mLengthSquared);
+		__m128 insideHit = _mm_andnot_ps(_mm_or_ps(_mm_cmpeq_ps(length, zero), notTowards), insideCorner);
+
+		__m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(a, c));
+		__m128 t = _mm_div_ps(_mm_sub_ps(negate(b), _mm_sqrt_ps(discriminant)), a);
+		__m128 outsideHit = _mm_andnot_ps(_mm_or_ps(_mm_or_ps(notTowards, _mm_cmplt_ps(discriminant, zero)), _mm_cmpgt_ps(t, one)), _mm_andnot_ps(insideCorner, _mm_cmpeq_ps(zero, zero)));
+
+		SweepLanes result;
+		result.hit = _mm_andnot_ps(missed, select(flat, flatHit, _mm_or_ps(insideHit, outsideHit)));
+		result.time = select(flat, time, select(insideCorner, zero, t));
+		result.normalX = select(flat, normalX, select(insideCorner, _mm_div_ps(mX, length), _mm_div_ps(_mm_add_ps(mX, _mm_mul_ps(motionX, t)), r)));
+		result.normalY = select(flat, normalY, select(insideCorner, _mm_div_ps(mY, length), _mm_div_ps(_mm_add_ps(mY, _mm_mul_ps(motionY, t)), r)));
+		return result;
+	}
+
+	// advanceCircleSwept on 4 lanes: the loop runs until every lane used up its step (or its bounces), a lane that is done is left as it is
+	void advanceBallSweptSSE(__m128& x, __m128& y, __m128& speedX, __m128& speedY, __m128 leftY, __m128 rightY, __m128 dt) const {
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+		const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), minusOne = _mm_set1_ps(-1.0f);
+		const __m128 five100 = _mm_set1_ps(500.0f), two = _mm_set1_ps(2.0f);
+		const __m128 height = _mm_set1_ps(paddleHeight);
+		const __m128 leftX = _mm_set1_ps(leftPaddleX), rightX = _mm_set1_ps(rightPaddleX);
+		const __m128 minX = _mm_set1_ps(ballBounds.minX), maxX = _mm_set1_ps(ballBounds.maxX);
+		const __m128 minY = _mm_set1_ps(ballBounds.minY), maxY = _mm_set1_ps(ballBounds.maxY);
+		const __m128 maxBounces = _mm_set1_ps(static_cast<float>(maxSweptBounces));
+		// Ball centers further from a paddle than this can't touch it, with a pixel to spare for rounding
+		const __m128 leftReach = _mm_set1_ps(leftPaddleX + paddleHalfWidth + radius + 1.0f);
+		const __m128 rightReach = _mm_set1_ps(rightPaddleX - paddleHalfWidth - radius - 1.0f);
+		auto absolute = [&](__m128 v) { return _mm_andnot_ps(signBit, v); };
+
+		__m128 remaining = dt;
+		__m128 bounces = zero;
+		__m128 active = _mm_cmpgt_ps(remaining, zero);
+		while (_mm_movemask_ps(active)) {
+			__m128 motionX = _mm_mul_ps(speedX, remaining), motionY = _mm_mul_ps(speedY, remaining);
+
+			// Earliest hit, a later test replaces it when it's as early (paddles) or earlier (walls), like the scalar ifs
+			__m128 earliest = one, normalX = zero, normalY = zero, hitPaddleY = zero;
+			__m128 paddleHit = zero, wallXHit = zero, wallYHit = zero;
+
+			// Most of the time every lane is far from both paddles, the sweep (a dozen divisions) is only run when one of
+			// them can get there this step. Skipping it only skips misses, so the results don't change
+			__m128 nearestX = _mm_min_ps(x, _mm_add_ps(x, motionX)), furthestX = _mm_max_ps(x, _mm_add_ps(x, motionX));
+			auto sweepPaddle = [&](__m128 paddleX, __m128 paddleY, __m128 inReach) {
+				if (!_mm_movemask_ps(_mm_and_ps(inReach, active))) return;
+				SweepLanes sweep = sweepPaddleSSE(x, y, motionX, motionY, paddleX, paddleY);
+				__m128 take = _mm_and_ps(sweep.hit, _mm_cmple_ps(sweep.time, earliest));
+				earliest = select(take, sweep.time, earliest);
+				normalX = select(take, sweep.normalX, normalX);
+				normalY = select(take, sweep.normalY, normalY);
+				hitPaddleY = select(take, paddleY, hitPaddleY);
+				paddleHit = _mm_or_ps(paddleHit, take);
+			};
+			sweepPaddle(leftX, leftY, _mm_cmple_ps(nearestX, leftReach));
+			sweepPaddle(rightX, rightY, _mm_cmpge_ps(furthestX, rightReach));
+
+			auto wall = [&](__m128 towards, __m128 crosses, __m128 limit, __m128 position, __m128 motion, __m128 wallNormalX, __m128 wallNormalY, bool isX) {
+				__m128 wallT = _mm_max_ps(_mm_div_ps(_mm_sub_ps(limit, position), motion), zero);
+				__m128 takeWall = _mm_and_ps(_mm_and_ps(towards, crosses), _mm_cmplt_ps(wallT, earliest));
+				earliest = select(takeWall, wallT, earliest);
+				normalX = select(takeWall, wallNormalX, normalX);
+				normalY = select(takeWall, wallNormalY, normalY);
+				paddleHit = _mm_andnot_ps(takeWall, paddleHit);
+				wallXHit = isX ? _mm_or_ps(wallXHit, takeWall) : _mm_andnot_ps(takeWall, wallXHit);
+				wallYHit = isX ? _mm_andnot_ps(takeWall, wallYHit) : _mm_or_ps(wallYHit, takeWall);
+			};
+			wall(_mm_cmplt_ps(motionX, zero), _mm_cmplt_ps(_mm_add_ps(x, motionX), minX), minX, x, motionX, one, zero, true);
+			wall(_mm_cmpgt_ps(motionX, zero), _mm_cmpgt_ps(_mm_add_ps(x, motionX), maxX), maxX, x, motionX, minusOne, zero, true);
+			wall(_mm_cmplt_ps(motionY, zero), _mm_cmplt_ps(_mm_add_ps(y, motionY), minY), minY, y, motionY, zero, one, false);
+			wall(_mm_cmpgt_ps(motionY, zero), _mm_cmpgt_ps(_mm_add_ps(y, motionY), maxY), maxY, y, motionY, zero, minusOne, false);
+
+			// Nothing hit, the lane moves the rest of the way and is done
+			__m128 anyHit = _mm_or_ps(paddleHit, _mm_or_ps(wallXHit, wallYHit));
+			__m128 clear = _mm_andnot_ps(anyHit, active);
+			x = select(clear, _mm_add_ps(x, motionX), x);
+			y = select(clear, _mm_add_ps(y, motionY), y);
+
+			// Move up to the hit and bounce
+			__m128 bounced = _mm_and_ps(anyHit, active);
+			paddleHit = _mm_and_ps(paddleHit, bounced);
+			wallXHit = _mm_and_ps(wallXHit, bounced);
+			wallYHit = _mm_and_ps(wallYHit, bounced);
+			x = select(bounced, _mm_add_ps(x, _mm_mul_ps(motionX, earliest)), x);
+			y = select(bounced, _mm_add_ps(y, _mm_mul_ps(motionY, earliest)), y);
+			remaining = select(bounced, _mm_sub_ps(remaining, _mm_mul_ps(remaining, earliest)), remaining);
+			bounces = select(bounced, _mm_add_ps(bounces, one), bounces);
+
+			// bounceOffBox: flat side, top/bottom, corner
+			__m128 side = _mm_and_ps(paddleHit, _mm_cmpeq_ps(normalY, zero));
+			__m128 topOrBottom = _mm_andnot_ps(side, _mm_and_ps(paddleHit, _mm_cmpeq_ps(normalX, zero)));
+			__m128 corner = _mm_andnot_ps(_mm_or_ps(side, topOrBottom), paddleHit);
+			__m128 dot = _mm_add_ps(_mm_mul_ps(speedX, normalX), _mm_mul_ps(speedY, normalY));
+			__m128 twoDot = _mm_mul_ps(two, dot);
+			__m128 newSpeedX = select(side, _mm_mul_ps(normalX, absolute(speedX)), select(corner, _mm_sub_ps(speedX, _mm_mul_ps(twoDot, normalX)), speedX));
+			__m128 newSpeedY = select(side, _mm_div_ps(_mm_div_ps(_mm_mul_ps(five100, _mm_sub_ps(y, hitPaddleY)), height), two),
+				select(topOrBottom, _mm_mul_ps(normalY, absolute(speedY)), select(corner, _mm_sub_ps(speedY, _mm_mul_ps(twoDot, normalY)), speedY)));
+
+			// Walls, snapped like the scalar version
+			x = select(wallXHit, select(_mm_cmpgt_ps(normalX, zero), minX, maxX), x);
+			newSpeedX = select(wallXHit, _mm_mul_ps(normalX, absolute(speedX)), newSpeedX);
+			y = select(wallYHit, select(_mm_cmpgt_ps(normalY, zero), minY, maxY), y);
+			newSpeedY = select(wallYHit, _mm_mul_ps(normalY, absolute(speedY)), newSpeedY);
+			speedX = newSpeedX;
+			speedY = newSpeedY;
+
+			active = _mm_and_ps(bounced, _mm_and_ps(_mm_cmpgt_ps(remaining, zero), _mm_cmplt_ps(bounces, maxBounces)));
+		}
+	}
+
+	void stepBlockSSE(int begin, int end, float timeStep) {
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+		const __m128 dt = _mm_set1_ps(timeStep);
+		const __m128 r = _mm_set1_ps(radius);
+		const __m128 speed = _mm_set1_ps(paddleSpeed);
+		const __m128 height = _mm_set1_ps(paddleHeight);
+		const __m128 halfHeight = _mm_set1_ps(paddleHalfHeight);
+		const __m128 five100 = _mm_set1_ps(500.0f);
+		const __m128 two = _mm_set1_ps(2.0f);
+		const __m128 leftX = _mm_set1_ps(leftPaddleX), rightX = _mm_set1_ps(rightPaddleX);
+		const __m128 leftContact = _mm_set1_ps(leftContactX), rightContact = _mm_set1_ps(rightContactX);
+		const __m128 left = _mm_set1_ps(areaLeft), right = _mm_set1_ps(areaRight);
+		const __m128 top = _mm_set1_ps(areaTop), bottom = _mm_set1_ps(areaBottom);
+		const __m128 minBallX = _mm_add_ps(left, r), maxBallX = _mm_sub_ps(right, r);
+		const __m128 minBallY = _mm_add_ps(top, r), maxBallY = _mm_sub_ps(bottom, r);
+		const __m128 minPaddleY = _mm_add_ps(top, halfHeight), maxPaddleY = _mm_sub_ps(bottom, halfHeight);
+
+		for (int i{ begin }; i < end; i += 4) {
+			__m128 x = _mm_loadu_ps(&ballX[i]);
+			__m128 y = _mm_loadu_ps(&ballY[i]);
+			__m128 speedX = _mm_loadu_ps(&ballSpeedX[i]);
+			__m128 speedY = _mm_loadu_ps(&ballSpeedY[i]);
+			__m128 leftY = _mm_loadu_ps(&leftPaddleY[i]);
+			__m128 rightY = _mm_loadu_ps(&rightPaddleY[i]);
+
+			// Update positions, the swept ball moves during the collitions
+			if (!continuousCollisions) {
+				x = _mm_add_ps(x, _mm_mul_ps(speedX, dt));
+				y = _mm_add_ps(y, _mm_mul_ps(speedY, dt));
+			}
+			leftY = _mm_add_ps(leftY, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&leftInput[i]), speed), dt));
+			rightY = _mm_add_ps(rightY, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&rightInput[i]), speed), dt));
+
+			if (continuousCollisions) {
+				advanceBallSweptSSE(x, y, speedX, speedY, leftY, rightY, dt);
+			}
+			else {
+				// Ball-paddle collitions, the right paddle is tested with the position the left one might have changed
+				__m128 hit = hitsPaddleSSE(x, y, leftX, leftY);
+				x = select(hit, leftContact, x);
+				speedX = _mm_xor_ps(speedX, _mm_and_ps(hit, signBit));
+				speedY = select(hit, _mm_div_ps(_mm_div_ps(_mm_mul_ps(five100, _mm_sub_ps(y, leftY)), height), two), speedY);
+
+				hit = hitsPaddleSSE(x, y, rightX, rightY);
+				x = select(hit, rightContact, x);
+				speedX = _mm_xor_ps(speedX, _mm_and_ps(hit, signBit));
+				speedY = select(hit, _mm_div_ps(_mm_div_ps(_mm_mul_ps(five100, _mm_sub_ps(y, rightY)), height), two), speedY);
+			}
+
+			// Constrain to the game area, one wall at a time like Ball::keepInsidePlayableArea
+			__m128 out = _mm_cmplt_ps(_mm_sub_ps(x, r), left);
+			x = select(out, minBallX, x);
+			speedX = _mm_xor_ps(speedX, _mm_and_ps(out, signBit));
+			out = _mm_cmpgt_ps(_mm_add_ps(x, r), right);
+			x = select(out, maxBallX, x);
+			speedX = _mm_xor_ps(speedX, _mm_and_ps(out, signBit));
+			out = _mm_cmplt_ps(_mm_sub_ps(y, r), top);
+			y = select(out, minBallY, y);
+			speedY = _mm_xor_ps(speedY, _mm_and_ps(out, signBit));
+			out = _mm_cmpgt_ps(_mm_add_ps(y, r), bottom);
+			y = select(out, maxBallY, y);
+			speedY = _mm_xor_ps(speedY, _mm_and_ps(out, signBit));
+
+			leftY = select(_mm_cmplt_ps(_mm_sub_ps(leftY, halfHeight), top), minPaddleY, leftY);
+			leftY = select(_mm_cmpgt_ps(_mm_add_ps(leftY, halfHeight), bottom), maxPaddleY, leftY);
+			rightY = select(_mm_cmplt_ps(_mm_sub_ps(rightY, halfHeight), top), minPaddleY, rightY);
+			rightY = select(_mm_cmpgt_ps(_mm_add_ps(rightY, halfHeight), bottom), maxPaddleY, rightY);
+
+			_mm_storeu_ps(&ballX[i], x);
+			_mm_storeu_ps(&ballY[i], y);
+			_mm_storeu_ps(&ballSpeedX[i], speedX);
+			_mm_storeu_ps(&ballSpeedY[i], speedY);
+			_mm_storeu_ps(&leftPaddleY[i], leftY);
+			_mm_storeu_ps(&rightPaddleY[i], rightY);
+		}
+	}
+#endif
+};
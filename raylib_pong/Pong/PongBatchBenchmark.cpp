@@ -0,0 +1,110 @@
+/*
+	Compares stepping N matches as PongGame objects (virtual calls, one match at a time) against stepping them with PongBatch.
+	Both start from the same random ball speeds and paddle inputs, at the end the states are compared to check the batch
+	is simulating the same game.
+
+	Usage: PongBatchBenchmark [matches = 100000] [steps = 1000] [threads = hardware threads]
+*/
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../../common/CommandLine.h"
+#include "PongBatch.h"
+#include "PongGameHeadless.h"
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+	int matches{ 100000 }, steps{ 1000 };
+	if ((argc > 1 && !parsePositive(argv[1], matches)) || (argc > 2 && !parsePositive(argv[2], steps))) {
+		std::cerr << "Usage: PongBatchBenchmark [matches = 100000] [steps = 1000] [threads = hardware threads], matches and steps at least 1" << std::endl;
+		return 1;
+	}
+	int threads = (argc > 3) ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+	if (threads < 1) threads = 1;
+
+	const PlayableRectangle gameArea{ 0, 0, 800, 600 };
+	const float timeStep{ 1.0f / 60.0f };
+	const Ball ballTemplate{ 5, -500 };
+	const Paddle paddleTemplate{ 10, 100, Paddle::LEFT, 500 };
+
+	// Same random setup for every run
+	std::mt19937 rng{ 2024 };
+	std::uniform_real_distribution<float> speedDistribution{ -300.0f, 300.0f };
+	std::uniform_int_distribution<int> inputDistribution{ -1, 1 };
+	std::vector<float> speedsY(matches);
+	std::vector<int> leftInputs(matches), rightInputs(matches);
+	for (int i{ 0 }; i < matches; ++i) {
+		speedsY[i] = speedDistribution(rng);
+		leftInputs[i] = inputDistribution(rng);
+		rightInputs[i] = inputDistribution(rng);
+	}
+
+	// PongGame objects, the vectors are reserved so the references the games hold stay valid
+	std::vector<Ball> balls;
+	std::vector<Paddle> leftPaddles, rightPaddles;
+	std::vector<PongGameHeadless> games;
+	balls.reserve(matches);
+	leftPaddles.reserve(matches);
+	rightPaddles.reserve(matches);
+	games.reserve(matches);
+	for (int i{ 0 }; i < matches; ++i) {
+		balls.emplace_back(5, -500.0f, speedsY[i]);
+		leftPaddles.emplace_back(10, 100, Paddle::LEFT, 500.0f);
+		rightPaddles.emplace_back(10, 100, Paddle::RIGHT, 500.0f);
+		games.emplace_back(gameArea, balls.back(), leftPaddles.back(), rightPaddles.back(), timeStep);
+		games.back().initialize();
+		games.back().leftInput = leftInputs[i];
+		games.back().rightInput = rightInputs[i];
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (int s{ 0 }; s < steps; ++s) {
+		for (auto& game : games)
+			game.update();
+	}
+	double objectSeconds = secondsSince(start);
+
+	auto makeBatch = [&]() {
+		PongBatch batch{ matches, gameArea, ballTemplate, paddleTemplate };
+		for (int i{ 0 }; i < matches; ++i) {
+			batch.setBallSpeed(i, -500.0f, speedsY[i]);
+			batch.setInputs(i, leftInputs[i], rightInputs[i]);
+		}
+		return batch;
+	};
+
+	PongBatch batch = makeBatch();
+	start = std::chrono::steady_clock::now();
+	batch.step(timeStep, steps, 1);
+	double batchSeconds = secondsSince(start);
+
+	PongBatch threadedBatch = makeBatch();
+	start = std::chrono::steady_clock::now();
+	threadedBatch.step(timeStep, steps, threads);
+	double threadedSeconds = secondsSince(start);
+
+	// Both have to be simulating the same thing for the numbers to mean anything
+	int mismatches{ 0 };
+	for (int i{ 0 }; i < matches; ++i) {
+		if (batch.ballX[i] != balls[i].position.x || batch.ballY[i] != balls[i].position.y ||
+			batch.leftPaddleY[i] != leftPaddles[i].position.y || batch.rightPaddleY[i] != rightPaddles[i].position.y ||
+			threadedBatch.ballX[i] != batch.ballX[i] || threadedBatch.ballY[i] != batch.ballY[i])
+			++mismatches;
+	}
+
+	double matchSteps = static_cast<double>(matches) * steps;
+	std::cout << matches << " matches x " << steps << " steps\n";
+	std::cout << "PongGame objects:        " << matchSteps / objectSeconds << " match-steps/s\n";
+	std::cout << "PongBatch (1 thread):    " << matchSteps / batchSeconds << " match-steps/s (x" << objectSeconds / batchSeconds << ")\n";
+	std::cout << "PongBatch (" << threads << " threads):   " << matchSteps / threadedSeconds << " match-steps/s (x" << objectSeconds / threadedSeconds << ")\n";
+	std::cout << "Matches that diverged from the objects: " << mismatches << std::endl;
+
+	return mismatches == 0 ? 0 : 1;
+}
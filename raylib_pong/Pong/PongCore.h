@@ -0,0 +1,158 @@
+/*
+	Game objects shared by the desktop game and the headless simulations. Nothing in here depends on raylib,
+	so it can be compiled without a window (batch simulation, benchmarks, replays...)
+*/
+#pragma once
+
+#include <cmath>
+
+struct Vector2 {
+	float x, y;
+};
+
+struct PlayableRectangle {
+	const Vector2 origin;
+	const Vector2 dimentions;
+
+	PlayableRectangle(int originX, int originY, int width, int height)
+		: origin{ static_cast<float>(originX), static_cast<float>(originY) }, dimentions{ static_cast<float>(width), static_cast<float>(height) } {
+	}
+};
+
+struct GameObject {
+	Vector2 position;
+	Vector2 speed;
+
+	GameObject(Vector2 position, Vector2 speed)
+		: position{ position }, speed{ speed } {}
+
+	virtual void keepInsidePlayableArea(const PlayableRectangle& rect) = 0;
+	virtual void positionInPlayableArea(const PlayableRectangle& rect) = 0;
+	virtual void updatePosition(float timeDelta) = 0;
+};
+
+struct Paddle : GameObject{
+	enum PaddleType {
+		LEFT = 0,
+		RIGHT
+	} type;
+
+	float width, height;
+
+	Paddle(int width, int height, PaddleType type, float speed = 1)
+		: GameObject{ {0.0, 0.0}, { 0.0, speed } }, type{ type }, width{ static_cast<float>(width) }, height{ static_cast<float>(height) } {}
+
+	// Another way we can do this and the ball too, is having a "positioner" class that will take care of the positioning of the objects
+	void positionInPlayableArea(const PlayableRectangle& rect) override {
+		switch (type) {
+		case PaddleType::RIGHT:
+			position.x = rect.origin.x + rect.dimentions.x - (0.0625 * rect.dimentions.x) - width/2;
+			break;
+		case PaddleType::LEFT:
+		default:
+			position.x = rect.origin.x + (0.0625 * rect.dimentions.x) + width/2;
+		}
+		position.y = rect.origin.y + rect.dimentions.y / 2;
+	}
+
+	void keepInsidePlayableArea(const PlayableRectangle& rect) override {
+		// Check y axis only, paddle can't mode in x axis
+		// Top edge
+		if (position.y - height/2 < rect.origin.y) {
+			position.y = rect.origin.y + height/2;
+			//speed.y *= -1; // Leaving this creates a funny behavior, try it out. It's not a bug it's a feature
+		}
+		// Bottom edge
+		if (position.y + height/2 > rect.origin.y + rect.dimentions.y) {
+			position.y = rect.origin.y + rect.dimentions.y - height/2;
+			//speed.y *= - 1; // Leaving this creates a funny behavior, try it out. It's not a bug it's a feature
+		}
+	}
+
+	void updatePosition(float deltaTime) override {
+		position.y += speed.y * deltaTime;
+	}
+};
+
+struct Ball : GameObject {
+	float radius;
+
+	Ball(int radiusInPixels, float speedX = 0.0, float speedY = 0.0)
+		: GameObject{ {0.0, 0.0}, {speedX, speedY} }, radius{ static_cast<float>(radiusInPixels) } {}
+
+	void positionInPlayableArea(const PlayableRectangle& rect) override {
+		position.x = (rect.origin.x + rect.dimentions.x) / 2.0;
+		position.y = (rect.origin.y + rect.dimentions.y) / 2.0;
+	}
+
+	void keepInsidePlayableArea(const PlayableRectangle& rect) override {
+		// Check xAxis
+		if (position.x - radius < rect.origin.x) {
+			position.x = rect.origin.x + radius;
+			speed.x *= -1;
+		}
+		if (position.x + radius > rect.origin.x + rect.dimentions.x) {
+			position.x = rect.origin.x + rect.dimentions.x - radius;
+			speed.x *= -1;
+		}
+		if (position.y - radius < rect.origin.y) {
+			position.y = rect.origin.y + radius;
+			speed.y *= -1;
+		}
+		if (position.y + radius > rect.origin.y + rect.dimentions.y) {
+			position.y = rect.origin.y + rect.dimentions.y - radius;
+			speed.y *= -1;
+		}
+	}
+
+	void handleCollisionWithPaddle(const Paddle& paddle) {
+		if (paddle.type == Paddle::LEFT) position.x = paddle.position.x + paddle.width / 2 + radius;
+		else position.x = paddle.position.x - paddle.width / 2 - radius;
+
+		speed.x *= -1;
+		speed.y = 500 * (position.y - paddle.position.y) / paddle.height / 2;
+	}
+
+	void updatePosition(float deltaTime) override {
+		position.x += speed.x * deltaTime;
+		position.y += speed.y * deltaTime;
+
+		// Here I could do bound checking
+	}
+};
+
+// Same test raylib does in CheckCollisionCircleRec, but paddles already store their center so we skip computing it
+inline bool checkCollisionBallPaddle(const Ball& ball, const Paddle& paddle) {
+	float dx = std::fabs(ball.position.x - paddle.position.x);
+	float dy = std::fabs(ball.position.y - paddle.position.y);
+
+	if (dx > paddle.width / 2 + ball.radius) return false;
+	if (dy > paddle.height / 2 + ball.radius) return false;
+
+	if (dx <= paddle.width / 2) return true;
+	if (dy <= paddle.height / 2) return true;
+
+	float cornerDx = dx - paddle.width / 2;
+	float cornerDy = dy - paddle.height / 2;
+	return cornerDx * cornerDx + cornerDy * cornerDy <= ball.radius * ball.radius;
+}
+
+struct PongGame {
+	const PlayableRectangle& gameArea;
+	Ball& ball;
+	Paddle& leftPaddle;
+	Paddle& rightPaddle;
+
+	PongGame(const PlayableRectangle& gameArea, Ball& ball, Paddle& leftPaddle, Paddle& rightPaddle)
+		: gameArea(gameArea), ball(ball), leftPaddle(leftPaddle), rightPaddle(rightPaddle) {}
+
+	virtual void initialize() = 0;
+	virtual void update() = 0;
+	virtual void render() = 0;
+	virtual bool end() = 0;
+	virtual void close() = 0;
+
+private:
+	virtual void manageCollitions() = 0;
+	virtual void constrainGameObjectsToGameArea() = 0;
+};
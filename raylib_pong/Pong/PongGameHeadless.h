@@ -0,0 +1,68 @@
+/*
+	PongGame without a window. Keys are replaced by a per paddle input (-1 up, 0 idle, 1 down) and the frame time by a fixed
+	time step, everything else follows the same order PongGameDesktop::update does.
+
+	continuousCollisions = false gives back the old end of step overlap test (PongBatch has the same switch).
+*/
+#pragma once
+
+#include "../../raylib_common/Profiler.h"
+#include "PongCore.h"
+#include "SweptCollision.h"
+
+struct PongGameHeadless : PongGame {
+	float timeStep;
+	int leftInput{ 0 };
+	int rightInput{ 0 };
+	bool continuousCollisions{ true };
+
+	PongGameHeadless(const PlayableRectangle& gameArea, Ball& ball, Paddle& leftPaddle, Paddle& rightPaddle, float timeStep = 1.0f / 60.0f)
+		: PongGame{ gameArea, ball, leftPaddle, rightPaddle }, timeStep{ timeStep } {}
+
+	void initialize() override {
+		ball.positionInPlayableArea(gameArea);
+		leftPaddle.positionInPlayableArea(gameArea);
+		rightPaddle.positionInPlayableArea(gameArea);
+	}
+
+	void update() override {
+		// Same as pressing W/S or UP/DOWN, the sign of the speed is what tells the direction
+		if (leftInput != 0) leftPaddle.speed.y = leftInput * std::fabs(leftPaddle.speed.y);
+		if (rightInput != 0) rightPaddle.speed.y = rightInput * std::fabs(rightPaddle.speed.y);
+
+		if (!continuousCollisions) ball.updatePosition(timeStep);
+		if (leftInput != 0) leftPaddle.updatePosition(timeStep);
+		if (rightInput != 0) rightPaddle.updatePosition(timeStep);
+
+		manageCollitions();
+
+		constrainGameObjectsToGameArea();
+	}
+
+	void render() override {}
+
+	bool end() override {
+		return false;
+	}
+
+	void close() override {}
+
+private:
+	void manageCollitions() override {
+		PROFILE_SCOPE("manageCollitions");
+		if (continuousCollisions) {
+			advanceBallSwept(ball, leftPaddle, rightPaddle, gameArea, timeStep);
+			return;
+		}
+
+		if (checkCollisionBallPaddle(ball, leftPaddle)) ball.handleCollisionWithPaddle(leftPaddle);
+		if (checkCollisionBallPaddle(ball, rightPaddle)) ball.handleCollisionWithPaddle(rightPaddle);
+	}
+
+	void constrainGameObjectsToGameArea() override {
+		PROFILE_SCOPE("constrainGameObjectsToGameArea");
+		ball.keepInsidePlayableArea(gameArea);
+		leftPaddle.keepInsidePlayableArea(gameArea);
+		rightPaddle.keepInsidePlayableArea(gameArea);
+	}
+};
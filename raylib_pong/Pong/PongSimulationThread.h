@@ -0,0 +1,175 @@
+/*
+	Runs a PongGameHeadless on its own thread at a fixed tick rate (one tick per game.timeStep), so the simulation no longer
+	depends on the frame rate: V-sync or a slow frame only delay what is drawn, the physics keep ticking on time.
+
+	The two threads never share the game objects:
+		- Simulation -> render: every tick publishes the state before and after it (PongSnapshot) to a TripleBuffer.
+		  The render thread draws one tick behind the newest state, interpolating between those two by the time passed
+		  since it was published, so the motion stays smooth whatever the ratio between tick rate and frame rate.
+		- Render -> simulation: the keys are read on the render thread (raylib wants that) and the paddle inputs are sent
+		  through an SpscQueue. The simulation applies them at the start of the next tick, so a recorded match still
+		  replays bit-exact.
+
+	Nothing in here needs raylib or a window, everything can be driven from a headless program (see
+	SimulationThreadBenchmark.cpp). With no thread started, tick() runs one step on the calling thread.
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "../../raylib_common/Profiler.h"
+#include "PongGameHeadless.h"
+#include "Replay.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+struct PongInput {
+	int8_t left{ 0 }; // -1 up, 0 idle, 1 down, like PongGameHeadless::leftInput
+	int8_t right{ 0 };
+
+	bool operator==(const PongInput& other) const { return left == other.left && right == other.right; }
+	bool operator!=(const PongInput& other) const { return !(*this == other); }
+};
+
+// What a tick publishes
+struct PongTickState {
+	PongSnapshot previous; // Before the tick
+	PongSnapshot current; // After it
+	double publishedAt{ 0 }; // Seconds since the PongSimulationThread was created
+};
+
+// Positions are interpolated, speeds are the ones of `to`
+inline PongSnapshot interpolateSnapshots(const PongSnapshot& from, const PongSnapshot& to, float alpha) {
+	auto lerp = [alpha](Vector2 a, Vector2 b) { return Vector2{ a.x + (b.x - a.x) * alpha, a.y + (b.y - a.y) * alpha }; };
+	PongSnapshot result = to;
+	result.ballPosition = lerp(from.ballPosition, to.ballPosition);
+	result.leftPaddlePosition = lerp(from.leftPaddlePosition, to.leftPaddlePosition);
+	result.rightPaddlePosition = lerp(from.rightPaddlePosition, to.rightPaddlePosition);
+	return result;
+}
+
+class PongSimulationThread {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr int maxCatchUpTicks{ 100 }; // Further behind than this, the missed ticks are dropped
+	static constexpr size_t inputQueueSize{ 64 };
+
+	// The game has to be initialized already. While the thread runs it is the only one touching the game, its objects and the recorder
+	explicit PongSimulationThread(PongGameHeadless& game, ReplayRecorder* recorder = nullptr)
+		: game{ game }, recorder{ recorder }, tickSeconds{ game.timeStep }, epoch{ Clock::now() },
+		  published{ PongTickState{ PongSnapshot::capture(game, 0), PongSnapshot::capture(game, 0), 0.0 } } {}
+
+	PongSimulationThread(const PongSimulationThread&) = delete;
+	PongSimulationThread& operator=(const PongSimulationThread&) = delete;
+
+	~PongSimulationThread() {
+		stop();
+	}
+
+	void start() {
+		if (running.exchange(true)) return;
+		thread = std::thread{ [this] { run(); } };
+	}
+
+	// Waits for the tick in progress to finish
+	void stop() {
+		running.store(false, std::memory_order_relaxed);
+		if (thread.joinable()) thread.join();
+	}
+
+	bool isRunning() const {
+		return running.load(std::memory_order_relaxed);
+	}
+
+	// Render thread. False if the queue is full (the simulation is stuck), send it again next frame
+	bool sendInput(PongInput input) {
+		return inputs.tryPush(input);
+	}
+
+	// Render thread: newest published tick
+	const PongTickState& latestTick() {
+		return published.read();
+	}
+
+	// Render thread: the state to draw at `seconds` (secondsSinceStart()), one tick behind the newest one
+	PongSnapshot stateAt(double seconds) {
+		const PongTickState& latest = published.read();
+		float alpha = static_cast<float>(std::clamp((seconds - latest.publishedAt) / tickSeconds, 0.0, 1.0));
+		return interpolateSnapshots(latest.previous, latest.current, alpha);
+	}
+
+	PongSnapshot stateToRender() {
+		return stateAt(secondsSinceStart());
+	}
+
+	double secondsSinceStart() const {
+		return std::chrono::duration<double>(Clock::now() - epoch).count();
+	}
+
+	float getTickSeconds() const { return tickSeconds; }
+	uint64_t tickCount() const { return ticks.load(std::memory_order_relaxed); }
+	uint64_t droppedTickCount() const { return droppedTicks.load(std::memory_order_relaxed); }
+
+	// One step: apply the inputs received, update, record, publish. Only call it directly when the thread isn't running
+	void tick() {
+		PROFILE_SCOPE("simulationTick");
+
+		// Inputs are held keys, only the newest one matters
+		PongInput input;
+		while (inputs.tryPop(input)) {
+			game.leftInput = input.left;
+			game.rightInput = input.right;
+		}
+
+		PongTickState& state = published.back();
+		state.previous = PongSnapshot::capture(game, step);
+		game.PongGameHeadless::update();
+		++step;
+		if (recorder) recorder->recordStep(game.leftInput, game.rightInput, game);
+		state.current = PongSnapshot::capture(game, step);
+		state.publishedAt = secondsSinceStart();
+		published.publish();
+
+		ticks.store(step, std::memory_order_relaxed);
+	}
+
+private:
+	PongGameHeadless& game;
+	ReplayRecorder* recorder;
+	const float tickSeconds;
+	const Clock::time_point epoch;
+
+	TripleBuffer<PongTickState> published;
+	SpscQueue<PongInput, inputQueueSize> inputs;
+
+	std::thread thread;
+	std::atomic<bool> running{ false };
+	uint64_t step{ 0 }; // Simulation thread only, ticks is the copy the others can read
+	std::atomic<uint64_t> ticks{ 0 };
+	std::atomic<uint64_t> droppedTicks{ 0 };
+
+	void run() {
+		const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(tickSeconds));
+		Clock::time_point next = Clock::now();
+
+		while (running.load(std::memory_order_relaxed)) {
+			tick();
+
+			// Deadlines instead of sleeping a period, so the time spent in tick() and sleep overshoots don't add up.
+			// When a sleep wakes up late the next deadlines are already past and the ticks run back to back until caught up
+			next += period;
+			Clock::time_point now = Clock::now();
+			if (now - next > maxCatchUpTicks * period) {
+				// Way behind (debugger, suspended machine...), running every missed tick at once would just freeze the game
+				droppedTicks.fetch_add(static_cast<uint64_t>((now - next) / period), std::memory_order_relaxed);
+				next = now;
+			}
+			std::this_thread::sleep_until(next);
+		}
+	}
+};
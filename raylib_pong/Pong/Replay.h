@@ -0,0 +1,291 @@
+/*
+	Deterministic replays for Pong.
+
+	The simulation only depends on the paddle inputs and the time step (see PongGameHeadless), so recording those is enough
+	to play a match again bit by bit. The log is a small binary file:
+
+		header:   "PONGRPL1", time step (float), snapshot interval (uint32), snapshot of the starting state
+		records:  'I' inputs (uint8) steps (varint)   -> the same inputs held for that many steps (run length encoded)
+		          'S' snapshot                        -> full state after that step, every `snapshot interval` steps
+		          'E' total steps (uint64)            -> end of the log
+
+	The snapshots are used to seek (restore the closest one and simulate the rest) and to check the replay is really
+	bit-exact, the player compares its own state against every snapshot it goes through.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "PongCore.h"
+#include "PongGameHeadless.h"
+
+struct PongSnapshot {
+	uint64_t step;
+	Vector2 ballPosition, ballSpeed;
+	Vector2 leftPaddlePosition, leftPaddleSpeed;
+	Vector2 rightPaddlePosition, rightPaddleSpeed;
+
+	static PongSnapshot capture(const PongGame& game, uint64_t step) {
+		return { step, game.ball.position, game.ball.speed,
+				 game.leftPaddle.position, game.leftPaddle.speed,
+				 game.rightPaddle.position, game.rightPaddle.speed };
+	}
+
+	void restore(PongGame& game) const {
+		game.ball.position = ballPosition;
+		game.ball.speed = ballSpeed;
+		game.leftPaddle.position = leftPaddlePosition;
+		game.leftPaddle.speed = leftPaddleSpeed;
+		game.rightPaddle.position = rightPaddlePosition;
+		game.rightPaddle.speed = rightPaddleSpeed;
+	}
+
+	bool sameStateAs(const PongSnapshot& other) const {
+		return std::memcmp(this, &other, sizeof(PongSnapshot)) == 0; // Bit-exact, no epsilon on purpose
+	}
+};
+
+namespace replay {
+	constexpr char magic[8]{ 'P', 'O', 'N', 'G', 'R', 'P', 'L', '1' };
+	constexpr uint32_t maxSnapshotInterval{ 1 << 20 }; // Anything bigger in a log is corruption
+
+	// Both inputs fit in one byte: 2 bits each, stored as input + 1 so -1/0/1 become 0/1/2
+	inline uint8_t packInputs(int left, int right) {
+		return static_cast<uint8_t>((left + 1) | ((right + 1) << 2));
+	}
+
+	inline int leftInput(uint8_t inputs) { return (inputs & 0x3) - 1; }
+	inline int rightInput(uint8_t inputs) { return ((inputs >> 2) & 0x3) - 1; }
+	// What packInputs can give: two fields of 0 to 2 and nothing above them
+	inline bool validInputs(uint8_t inputs) { return inputs < 16 && (inputs & 0x3) <= 2 && ((inputs >> 2) & 0x3) <= 2; }
+
+	template <typename T> void write(std::ostream& os, const T& value) {
+		os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T> T read(std::istream& is) {
+		T value;
+		if (!is.read(reinterpret_cast<char*>(&value), sizeof(T)))
+			throw std::runtime_error("Replay log is truncated");
+		return value;
+	}
+
+	inline void writeVarint(std::ostream& os, uint64_t value) {
+		while (value >= 0x80) {
+			os.put(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		os.put(static_cast<char>(value));
+	}
+
+	inline uint64_t readVarint(std::istream& is) {
+		uint64_t value{ 0 };
+		for (int shift{ 0 }; shift < 64; shift += 7) {
+			uint8_t byte = read<uint8_t>(is);
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if (!(byte & 0x80)) return value;
+		}
+		throw std::runtime_error("Replay log has a malformed varint");
+	}
+}
+
+class ReplayRecorder {
+public:
+	// The game has to be in its starting state already (initialize() called)
+	ReplayRecorder(const std::string& filename, const PongGame& game, float timeStep, uint32_t snapshotInterval = 600)
+		: ofs{ filename, std::ios::binary }, snapshotInterval{ snapshotInterval } {
+		if (snapshotInterval == 0 || snapshotInterval > replay::maxSnapshotInterval)
+			throw std::invalid_argument("Snapshot interval has to be between 1 and " + std::to_string(replay::maxSnapshotInterval));
+		if (!ofs) throw std::runtime_error("Could not open " + filename + " for writing");
+
+		ofs.write(replay::magic, sizeof(replay::magic));
+		replay::write(ofs, timeStep);
+		replay::write(ofs, snapshotInterval);
+		replay::write(ofs, PongSnapshot::capture(game, 0));
+	}
+
+	ReplayRecorder(const ReplayRecorder&) = delete;
+	ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+	~ReplayRecorder() {
+		close();
+	}
+
+	// Call once per simulation step, after the step, with the inputs that step used
+	void recordStep(int left, int right, const PongGame& game) {
+		uint8_t inputs = replay::packInputs(left, right);
+		if (runLength > 0 && inputs != runInputs) flushRun();
+		runInputs = inputs;
+		++runLength;
+		++steps;
+
+		if (steps % snapshotInterval == 0) {
+			flushRun();
+			ofs.put('S');
+			replay::write(ofs, PongSnapshot::capture(game, steps));
+		}
+	}
+
+	uint64_t stepCount() const {
+		return steps;
+	}
+
+	void close() {
+		if (!ofs.is_open()) return;
+		flushRun();
+		ofs.put('E');
+		replay::write(ofs, steps);
+		ofs.close();
+	}
+
+private:
+	std::ofstream ofs;
+	uint32_t snapshotInterval;
+	uint64_t steps{ 0 };
+	uint8_t runInputs{ 0 };
+	uint64_t runLength{ 0 };
+
+	void flushRun() {
+		if (runLength == 0) return;
+		ofs.put('I');
+		ofs.put(static_cast<char>(runInputs));
+		replay::writeVarint(ofs, runLength);
+		runLength = 0;
+	}
+};
+
+class ReplayPlayer {
+public:
+	// Drives `game`, overwriting its state and time step with the ones in the log
+	ReplayPlayer(const std::string& filename, PongGameHeadless& game)
+		: game{ game } {
+		std::ifstream ifs{ filename, std::ios::binary };
+		if (!ifs) throw std::runtime_error("Could not open " + filename);
+
+		char fileMagic[sizeof(replay::magic)];
+		if (!ifs.read(fileMagic, sizeof(fileMagic)) || std::memcmp(fileMagic, replay::magic, sizeof(fileMagic)) != 0)
+			throw std::runtime_error(filename + " is not a Pong replay");
+
+		timeStep = replay::read<float>(ifs);
+		snapshotInterval = replay::read<uint32_t>(ifs);
+		if (!(timeStep > 0) || !std::isfinite(timeStep))
+			throw std::runtime_error("Replay log has an invalid time step");
+		if (snapshotInterval == 0 || snapshotInterval > replay::maxSnapshotInterval)
+			throw std::runtime_error("Replay log has an invalid snapshot interval");
+		// seek() resumes from a snapshot's step, so every snapshot has to be at the step its position says
+		auto readSnapshot = [&]() {
+			PongSnapshot snapshot = replay::read<PongSnapshot>(ifs);
+			if (snapshot.step != snapshots.size() * static_cast<uint64_t>(snapshotInterval))
+				throw std::runtime_error("Replay log has a snapshot at the wrong step");
+			snapshots.push_back(snapshot);
+		};
+		readSnapshot();
+
+		// The recorder writes a snapshot every snapshotInterval steps, so the bytes left in the file limit how many steps the
+		// log can still have. That bounds every run before it is allocated, a corrupt count can't ask for gigabytes
+		const std::streamoff dataStart = ifs.tellg();
+		ifs.seekg(0, std::ios::end);
+		const uint64_t fileSize = static_cast<uint64_t>(ifs.tellg());
+		ifs.seekg(dataStart);
+		const uint64_t snapshotRecordSize = 1 + sizeof(PongSnapshot);
+
+		bool ended{ false };
+		while (!ended) {
+			switch (replay::read<char>(ifs)) {
+			case 'I': {
+				uint8_t packed = replay::read<uint8_t>(ifs);
+				if (!replay::validInputs(packed))
+					throw std::runtime_error("Replay log has invalid inputs");
+				uint64_t run = replay::readVarint(ifs);
+				uint64_t bytesLeft = fileSize - static_cast<uint64_t>(ifs.tellg());
+				uint64_t maxSteps = (snapshots.size() + bytesLeft / snapshotRecordSize) * snapshotInterval;
+				if (run > maxSteps - std::min<uint64_t>(maxSteps, inputs.size()))
+					throw std::runtime_error("Replay log has more steps than its size allows");
+				inputs.insert(inputs.end(), run, packed);
+				break;
+			}
+			case 'S':
+				readSnapshot();
+				break;
+			case 'E':
+				if (replay::read<uint64_t>(ifs) != inputs.size())
+					throw std::runtime_error("Replay log step count doesn't match its inputs");
+				if (snapshots.size() != inputs.size() / snapshotInterval + 1)
+					throw std::runtime_error("Replay log is missing snapshots"); // step() and seek() index them by step
+				ended = true;
+				break;
+			default:
+				throw std::runtime_error("Replay log has an unknown record");
+			}
+		}
+
+		game.timeStep = timeStep;
+		rewind();
+	}
+
+	uint64_t stepCount() const { return inputs.size(); }
+	uint64_t currentStep() const { return current; }
+	float getTimeStep() const { return timeStep; }
+	bool finished() const { return current >= inputs.size(); }
+	int desyncCount() const { return desyncs; }
+
+	void rewind() {
+		snapshots.front().restore(game);
+		current = 0;
+	}
+
+	// Simulates one step, returns false once the log is over
+	bool step() {
+		if (finished()) return false;
+
+		uint8_t packed = inputs[current++];
+		game.leftInput = replay::leftInput(packed);
+		game.rightInput = replay::rightInput(packed);
+		game.PongGameHeadless::update(); // Qualified, a derived game (PongGameDesktop) would read the keyboard instead
+
+		if (current % snapshotInterval == 0) {
+			const PongSnapshot& expected = snapshots[current / snapshotInterval];
+			if (!PongSnapshot::capture(game, current).sameStateAs(expected)) ++desyncs;
+		}
+		return true;
+	}
+
+	// Restores the closest snapshot before `target` and simulates from there, so seeking costs at most one snapshot interval
+	void seek(uint64_t target) {
+		if (target > inputs.size()) target = inputs.size();
+
+		if (target < current || target - current > snapshotInterval) {
+			uint64_t snapshotIndex = target / snapshotInterval;
+			if (snapshotIndex >= snapshots.size()) snapshotIndex = snapshots.size() - 1;
+			snapshots[snapshotIndex].restore(game);
+			current = snapshots[snapshotIndex].step;
+		}
+
+		while (current < target)
+			step();
+	}
+
+	// Plays everything from the start as fast as possible, true if every snapshot matched
+	bool verify() {
+		rewind();
+		desyncs = 0;
+		while (step()) {}
+		return desyncs == 0;
+	}
+
+private:
+	PongGameHeadless& game;
+	float timeStep;
+	uint32_t snapshotInterval;
+	std::vector<uint8_t> inputs; // One packed byte per step
+	std::vector<PongSnapshot> snapshots; // snapshots[i] is the state after step i * snapshotInterval
+	uint64_t current{ 0 };
+	int desyncs{ 0 };
+};
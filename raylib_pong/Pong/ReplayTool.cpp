@@ -0,0 +1,95 @@
+/*
+	Headless companion to the replay system, no window needed.
+
+	Usage:
+		ReplayTool record <file> [steps = 100000]   records a match with random paddle inputs
+		ReplayTool play <file>                      plays the log at full speed, checks it against its snapshots and tests seeking
+*/
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#include "../../common/CommandLine.h"
+#include "PongGameHeadless.h"
+#include "Replay.h"
+
+int record(const char* filename, uint64_t steps) {
+	const PlayableRectangle gameArea{ 0, 0, 800, 600 };
+	Ball ball{ 5, -500 };
+	Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
+	Paddle rightPaddle{ 10, 100, Paddle::RIGHT, 500 };
+	PongGameHeadless game{ gameArea, ball, leftPaddle, rightPaddle, 1.0f / 120.0f };
+	game.initialize();
+
+	ReplayRecorder recorder{ filename, game, game.timeStep };
+
+	// Inputs held for a random number of steps, like a person pressing keys
+	std::mt19937 rng{ std::random_device{}() };
+	std::uniform_int_distribution<int> inputDistribution{ -1, 1 };
+	std::uniform_int_distribution<int> holdDistribution{ 1, 60 };
+	int holdLeft{ 0 }, holdRight{ 0 };
+
+	for (uint64_t s{ 0 }; s < steps; ++s) {
+		if (--holdLeft <= 0) { game.leftInput = inputDistribution(rng); holdLeft = holdDistribution(rng); }
+		if (--holdRight <= 0) { game.rightInput = inputDistribution(rng); holdRight = holdDistribution(rng); }
+		game.update();
+		recorder.recordStep(game.leftInput, game.rightInput, game);
+	}
+	recorder.close();
+
+	std::cout << "Recorded " << steps << " steps to " << filename << std::endl;
+	return 0;
+}
+
+int play(const char* filename) {
+	const PlayableRectangle gameArea{ 0, 0, 800, 600 };
+	Ball ball{ 5 };
+	Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
+	Paddle rightPaddle{ 10, 100, Paddle::RIGHT, 500 };
+	PongGameHeadless game{ gameArea, ball, leftPaddle, rightPaddle };
+
+	ReplayPlayer player{ filename, game };
+
+	auto start = std::chrono::steady_clock::now();
+	bool exact = player.verify();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	PongSnapshot finalState = PongSnapshot::capture(game, player.currentStep());
+
+	std::cout << player.stepCount() << " steps (" << player.stepCount() * player.getTimeStep() << " s of game) replayed in "
+		<< seconds << " s, " << player.stepCount() / seconds << " steps/s\n";
+	if (exact) std::cout << "Bit-exact, every snapshot matched\n";
+	else std::cout << "DESYNC: " << player.desyncCount() << " snapshots didn't match\n";
+
+	// Seeking backwards then forwards has to land in the very same final state
+	player.seek(player.stepCount() / 3);
+	player.seek(player.stepCount() / 7);
+	player.seek(player.stepCount());
+	bool seekExact = PongSnapshot::capture(game, player.currentStep()).sameStateAs(finalState);
+	std::cout << "Seeking " << (seekExact ? "reproduces" : "DOES NOT reproduce") << " the final state" << std::endl;
+
+	return (exact && seekExact) ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+	try {
+		if (argc > 2 && std::strcmp(argv[1], "record") == 0) {
+			uint64_t steps{ 100000 };
+			if (argc > 3 && !parsePositive(argv[3], steps)) {
+				std::cerr << "Error: the step count has to be a positive integer" << std::endl;
+				return 1;
+			}
+			return record(argv[2], steps);
+		}
+		if (argc > 2 && std::strcmp(argv[1], "play") == 0)
+			return play(argv[2]);
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	std::cerr << "Usage: ReplayTool record <file> [steps] | ReplayTool play <file>" << std::endl;
+	return 1;
+}
@@ -0,0 +1,178 @@
+/*
+	Headless check of PongSimulationThread, no window needed.
+
+	1. Hand-off stress: a writer publishes through a TripleBuffer and pushes through an SpscQueue as fast as it can while
+	   the reader takes them. Every published value is a block of copies of the same counter, so a torn read (a slot
+	   written while being read) shows up as a block that isn't all the same number.
+	2. The game: the simulation thread ticks at the given rate and records a replay while this thread acts like the
+	   renderer at 60 frames per second (sending inputs, reading and interpolating states). Every second one frame
+	   takes 250 ms, the simulation has to keep ticking during it. At the end the replay is played back on this thread
+	   and has to match the threaded run bit by bit.
+
+	Usage: SimulationThreadBenchmark [tick rate = 1000] [seconds = 3]
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "PongSimulationThread.h"
+
+struct Stamped {
+	uint64_t values[16];
+};
+
+int handOffStress(double seconds) {
+	TripleBuffer<Stamped> buffer{ Stamped{} };
+	SpscQueue<uint64_t, 1024> queue;
+	std::atomic<bool> done{ false };
+
+	uint64_t published{ 0 }, pushed{ 0 };
+	std::thread writer{ [&] {
+		while (!done.load(std::memory_order_relaxed)) {
+			Stamped& slot = buffer.back();
+			++published;
+			std::fill(std::begin(slot.values), std::end(slot.values), published);
+			buffer.publish();
+			if (queue.tryPush(pushed + 1)) ++pushed;
+		}
+	} };
+
+	uint64_t reads{ 0 }, newValues{ 0 }, torn{ 0 }, outOfOrder{ 0 }, lastValue{ 0 };
+	uint64_t popped{ 0 }, queueErrors{ 0 }, value;
+	auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+	while (std::chrono::steady_clock::now() < end) {
+		for (int i{ 0 }; i < 1000; ++i) {
+			++reads;
+			if (buffer.update()) {
+				++newValues;
+				const Stamped& read = buffer.front();
+				if (!std::all_of(std::begin(read.values), std::end(read.values), [&](uint64_t v) { return v == read.values[0]; })) ++torn;
+				if (read.values[0] <= lastValue) ++outOfOrder;
+				lastValue = read.values[0];
+			}
+			while (queue.tryPop(value)) {
+				if (value != ++popped) ++queueErrors;
+			}
+		}
+	}
+	done = true;
+	writer.join();
+	while (queue.tryPop(value)) {
+		if (value != ++popped) ++queueErrors;
+	}
+	if (popped != pushed) ++queueErrors;
+
+	std::cout << "Hand-off: " << published << " published, " << newValues << " new values seen in " << reads << " reads, "
+		<< torn << " torn, " << outOfOrder << " out of order. Queue: " << pushed << " pushed, " << popped << " popped, "
+		<< queueErrors << " errors\n";
+	return (torn == 0 && outOfOrder == 0 && queueErrors == 0) ? 0 : 1;
+}
+
+int threadedGame(float tickRate, double seconds) {
+	const PlayableRectangle gameArea{ 0, 0, 800, 600 };
+	const char* replayFile{ "simulation_thread_check.rpl" };
+	const double frameSeconds{ 1.0 / 60.0 };
+	const double stallSeconds{ 0.25 };
+
+	Ball ball{ 5, -500, 170 };
+	Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
+	Paddle rightPaddle{ 10, 100, Paddle::RIGHT, 500 };
+	PongGameHeadless game{ gameArea, ball, leftPaddle, rightPaddle, 1.0f / tickRate };
+	game.initialize();
+
+	int failures{ 0 };
+	uint64_t frames{ 0 }, stalls{ 0 }, minTicksInStall{ UINT64_MAX }, inputsSent{ 0 };
+	double maxStaleness{ 0 };
+	double runSeconds;
+	uint64_t tickCount, dropped;
+	{
+		ReplayRecorder recorder{ replayFile, game, game.timeStep };
+		PongSimulationThread simulation{ game, &recorder };
+		simulation.start();
+
+		PongInput sent;
+		uint64_t lastStep{ 0 };
+		double start = simulation.secondsSinceStart();
+		double nextFrame = start;
+		while (simulation.secondsSinceStart() - start < seconds) {
+			double now = simulation.secondsSinceStart();
+
+			// Paddles change direction every half second
+			int phase = static_cast<int>(now * 2);
+			PongInput input{ static_cast<int8_t>((phase & 1) ? 1 : -1), static_cast<int8_t>((phase % 3) - 1) };
+			if (input != sent && simulation.sendInput(input)) {
+				sent = input;
+				++inputsSent;
+			}
+
+			// What the render thread does
+			const PongTickState& latest = simulation.latestTick();
+			bool firstTickYet = latest.current.step > 0; // Until then both are the starting state
+			if ((firstTickYet && latest.current.step != latest.previous.step + 1) || latest.current.step < lastStep) ++failures;
+			lastStep = latest.current.step;
+			maxStaleness = std::max(maxStaleness, now - latest.publishedAt);
+			PongSnapshot drawn = simulation.stateAt(now);
+			auto between = [](float v, float a, float b) { return v >= std::min(a, b) - 1e-3f && v <= std::max(a, b) + 1e-3f; };
+			if (!between(drawn.ballPosition.x, latest.previous.ballPosition.x, latest.current.ballPosition.x)) ++failures;
+			++frames;
+
+			if (frames % 60 == 0) {
+				// A slow frame, the simulation shouldn't notice
+				uint64_t before = simulation.tickCount();
+				std::this_thread::sleep_for(std::chrono::duration<double>(stallSeconds));
+				minTicksInStall = std::min(minTicksInStall, simulation.tickCount() - before);
+				++stalls;
+			}
+
+			nextFrame += frameSeconds;
+			std::this_thread::sleep_until(PongSimulationThread::Clock::now() + std::chrono::duration<double>(std::max(0.0, nextFrame - simulation.secondsSinceStart())));
+		}
+
+		simulation.stop();
+		runSeconds = simulation.secondsSinceStart() - start;
+		tickCount = simulation.tickCount();
+		dropped = simulation.droppedTickCount();
+		recorder.close();
+	}
+
+	// Same inputs on the same ticks, on a single thread
+	Ball replayBall{ 5, -500, 170 };
+	Paddle replayLeft{ 10, 100, Paddle::LEFT, 500 };
+	Paddle replayRight{ 10, 100, Paddle::RIGHT, 500 };
+	PongGameHeadless replayGame{ gameArea, replayBall, replayLeft, replayRight };
+	ReplayPlayer player{ replayFile, replayGame };
+	bool replayMatches = player.verify() && player.stepCount() == tickCount
+		&& PongSnapshot::capture(replayGame, tickCount).sameStateAs(PongSnapshot::capture(game, tickCount));
+	std::remove(replayFile);
+
+	const double expectedTicksInStall = stallSeconds * tickRate;
+	std::cout << std::fixed << std::setprecision(1)
+		<< "Game: " << tickCount << " ticks in " << runSeconds << " s (" << tickCount / runSeconds << " per second, target "
+		<< tickRate << "), " << dropped << " dropped\n"
+		<< "      " << frames << " frames, " << inputsSent << " inputs sent, newest state at most "
+		<< maxStaleness * 1000 << " ms old when drawn\n"
+		<< "      " << stalls << " stalled frames of " << stallSeconds * 1000 << " ms, at least " << (stalls ? minTicksInStall : 0)
+		<< " ticks during each (" << expectedTicksInStall << " expected)\n"
+		<< "      " << failures << " inconsistent states, replay " << (replayMatches ? "matches" : "DOESN'T match") << "\n";
+
+	bool kept = stalls == 0 || minTicksInStall >= 0.8 * expectedTicksInStall;
+	return (failures == 0 && replayMatches && kept) ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+	float tickRate = (argc > 1) ? static_cast<float>(std::atof(argv[1])) : 1000.0f;
+	double seconds = (argc > 2) ? std::atof(argv[2]) : 3.0;
+	if (tickRate <= 0 || seconds <= 0) {
+		std::cerr << "Usage: SimulationThreadBenchmark [tick rate = 1000] [seconds = 3]\n";
+		return 1;
+	}
+
+	int result = handOffStress(std::min(seconds, 1.0));
+	result |= threadedGame(tickRate, seconds);
+	return result;
+}
@@ -0,0 +1,66 @@
+/*
+Bounded lock-free queue for exactly one producer thread and one consumer thread.
+
+A ring of Capacity slots (a power of two, the index is a mask) with two counters that only ever grow: the producer
+writes at tail, the consumer reads at head. Each side only stores its own counter and reads the other one, and each
+keeps a cached copy of the other's counter so it only has to touch the other side's cache line when the queue looks
+full (producer) or empty (consumer).
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+
+template <typename T, size_t Capacity>
+class SpscQueue {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity has to be a power of two");
+
+public:
+	SpscQueue() = default;
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	// Producer thread only. False if the queue is full, nothing is written then
+	bool tryPush(const T& value) {
+		size_t currentTail = tail.load(std::memory_order_relaxed);
+		if (currentTail - cachedHead == Capacity) {
+			cachedHead = head.load(std::memory_order_acquire);
+			if (currentTail - cachedHead == Capacity) return false;
+		}
+		ring[currentTail & (Capacity - 1)] = value;
+		tail.store(currentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer thread only. False if the queue is empty
+	bool tryPop(T& value) {
+		size_t currentHead = head.load(std::memory_order_relaxed);
+		if (currentHead == cachedTail) {
+			cachedTail = tail.load(std::memory_order_acquire);
+			if (currentHead == cachedTail) return false;
+		}
+		value = ring[currentHead & (Capacity - 1)];
+		head.store(currentHead + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Only exact when neither side is running
+	size_t size() const {
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+	static constexpr size_t capacity() {
+		return Capacity;
+	}
+
+private:
+	std::array<T, Capacity> ring{};
+
+	alignas(64) std::atomic<size_t> head{ 0 }; // Next slot to read, stored by the consumer
+	size_t cachedTail{ 0 }; // Consumer's copy of tail
+
+	alignas(64) std::atomic<size_t> tail{ 0 }; // Next slot to write, stored by the producer
+	size_t cachedHead{ 0 }; // Producer's copy of head
+};
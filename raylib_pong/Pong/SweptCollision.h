@@ -0,0 +1,229 @@
+/*
+	Continuous (swept) collision detection for the ball, no raylib needed so it works headless too.
+
+	Testing for overlap only at the end of the frame lets a fast ball (or a long frame) jump over a 10 pixel paddle. Instead,
+	the ball is moved along its path and stopped at the exact time of impact, it bounces and keeps going with the time that
+	was left, as many times as needed within the step.
+
+	The ball against a paddle is the same as a point against the paddle grown by the ball radius, which is a rectangle with
+	rounded corners. So the test is a ray against the grown rectangle, and if the ray enters it near a corner, a ray against
+	that corner circle.
+
+	The math works on SweepBox/plain floats so PongBatch can run the very same code on its arrays, the Ball/Paddle versions
+	just unpack the objects.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "PongCore.h"
+
+constexpr int maxSweptBounces{ 8 };
+
+struct SweepHit {
+	float time; // Fraction of the motion at which the ball touches, [0, 1]
+	Vector2 normal; // Points out of the surface that was hit
+};
+
+// A paddle as far as the sweep is concerned
+struct SweepBox {
+	Vector2 center;
+	float halfWidth, halfHeight;
+	float height; // For the bounce, same as 2 * halfHeight
+};
+
+// Where the ball center can be, the playable area shrunk by the radius
+struct SweepBounds {
+	float minX, maxX, minY, maxY;
+};
+
+inline SweepBox sweepBoxOf(const Paddle& paddle) {
+	return { paddle.position, paddle.width / 2, paddle.height / 2, paddle.height };
+}
+
+// Sweeps a circle starting at `center` moving `motion` against a box that stays still during the sweep
+inline bool sweepCircleBox(Vector2 center, float radius, Vector2 motion, const SweepBox& box, SweepHit& hit) {
+	const float halfWidth = box.halfWidth, halfHeight = box.halfHeight;
+	const float grownHalfWidth = halfWidth + radius, grownHalfHeight = halfHeight + radius;
+
+	// Work relative to the box center
+	Vector2 relative{ center.x - box.center.x, center.y - box.center.y };
+
+	// Ray against the grown rectangle (slab test)
+	float enter = -std::numeric_limits<float>::infinity();
+	float exit = std::numeric_limits<float>::infinity();
+	Vector2 normal{ 0, 0 };
+
+	if (motion.x == 0) {
+		if (std::fabs(relative.x) > grownHalfWidth) return false;
+	}
+	else {
+		float t1 = (-grownHalfWidth - relative.x) / motion.x;
+		float t2 = (grownHalfWidth - relative.x) / motion.x;
+		float nearT = std::min(t1, t2), farT = std::max(t1, t2);
+		if (nearT > enter) { enter = nearT; normal = { motion.x > 0 ? -1.0f : 1.0f, 0 }; }
+		exit = std::min(exit, farT);
+	}
+
+	if (motion.y == 0) {
+		if (std::fabs(relative.y) > grownHalfHeight) return false;
+	}
+	else {
+		float t1 = (-grownHalfHeight - relative.y) / motion.y;
+		float t2 = (grownHalfHeight - relative.y) / motion.y;
+		float nearT = std::min(t1, t2), farT = std::max(t1, t2);
+		if (nearT > enter) { enter = nearT; normal = { 0, motion.y > 0 ? -1.0f : 1.0f }; }
+		exit = std::min(exit, farT);
+	}
+
+	if (enter > exit || exit < 0 || enter > 1) return false;
+
+	float time = std::max(enter, 0.0f);
+	Vector2 point{ relative.x + motion.x * time, relative.y + motion.y * time };
+
+	// Entered through one of the flat sides
+	if (std::fabs(point.x) <= halfWidth || std::fabs(point.y) <= halfHeight) {
+		if (enter < 0) {
+			// Already overlapping at the start of the step, push out through the side with the least penetration
+			float penetrationX = grownHalfWidth - std::fabs(relative.x);
+			float penetrationY = grownHalfHeight - std::fabs(relative.y);
+			if (penetrationX < penetrationY) normal = { relative.x < 0 ? -1.0f : 1.0f, 0 };
+			else normal = { 0, relative.y < 0 ? -1.0f : 1.0f };
+		}
+		// Moving away already (e.g. right after a bounce), let it leave
+		if (motion.x * normal.x + motion.y * normal.y >= 0) return false;
+
+		hit = { time, normal };
+		return true;
+	}
+
+	// Entered through a corner square, test against the corner circle
+	Vector2 corner{ point.x < 0 ? -halfWidth : halfWidth, point.y < 0 ? -halfHeight : halfHeight };
+	Vector2 m{ relative.x - corner.x, relative.y - corner.y };
+	float a = motion.x * motion.x + motion.y * motion.y;
+	float b = m.x * motion.x + m.y * motion.y;
+	float c = m.x * m.x + m.y * m.y - radius * radius;
+
+	if (c <= 0) {
+		// Started inside the corner circle
+		float length = std::sqrt(m.x * m.x + m.y * m.y);
+		if (length == 0 || b >= 0) return false;
+		hit = { 0, { m.x / length, m.y / length } };
+		return true;
+	}
+
+	float discriminant = b * b - a * c;
+	if (b >= 0 || discriminant < 0) return false;
+
+	float t = (-b - std::sqrt(discriminant)) / a;
+	if (t > 1) return false;
+
+	hit = { t, { (m.x + motion.x * t) / radius, (m.y + motion.y * t) / radius } };
+	return true;
+}
+
+inline bool sweepBallPaddle(Vector2 center, float radius, Vector2 motion, const Paddle& paddle, SweepHit& hit) {
+	return sweepCircleBox(center, radius, motion, sweepBoxOf(paddle), hit);
+}
+
+// Bounce off the box. The flat sides keep the same "english" Ball::handleCollisionWithPaddle gives, corners reflect
+inline void bounceOffBox(Vector2 position, Vector2& speed, const SweepBox& box, Vector2 normal) {
+	if (normal.y == 0) {
+		speed.x = normal.x * std::fabs(speed.x);
+		speed.y = 500 * (position.y - box.center.y) / box.height / 2;
+	}
+	else if (normal.x == 0) {
+		speed.y = normal.y * std::fabs(speed.y);
+	}
+	else {
+		float dot = speed.x * normal.x + speed.y * normal.y;
+		speed.x -= 2 * dot * normal.x;
+		speed.y -= 2 * dot * normal.y;
+	}
+}
+
+inline void bounceBallOffPaddle(Ball& ball, const Paddle& paddle, Vector2 normal) {
+	bounceOffBox(ball.position, ball.speed, sweepBoxOf(paddle), normal);
+}
+
+/*
+	Moves a circle `deltaTime` seconds resolving every bounce (paddles and walls) on the way. After `maxBounces` bounces the
+	rest of the step is dropped, that only happens if the ball gets pinned (e.g. between a paddle and a wall).
+	Returns the number of bounces.
+*/
+inline int advanceCircleSwept(Vector2& position, Vector2& speed, float radius, const SweepBox& leftPaddle, const SweepBox& rightPaddle, const SweepBounds& bounds, float deltaTime, int maxBounces = maxSweptBounces) {
+	const float minX = bounds.minX, maxX = bounds.maxX;
+	const float minY = bounds.minY, maxY = bounds.maxY;
+
+	float remaining = deltaTime;
+	int bounces{ 0 };
+
+	while (remaining > 0 && bounces < maxBounces) {
+		Vector2 motion{ speed.x * remaining, speed.y * remaining };
+
+		enum { NONE, PADDLE, WALL_X, WALL_Y } hitType{ NONE };
+		const SweepBox* hitPaddle{ nullptr };
+		SweepHit earliest{ 1.0f, { 0, 0 } };
+
+		for (const SweepBox* paddle : { &leftPaddle, &rightPaddle }) {
+			SweepHit hit;
+			if (sweepCircleBox(position, radius, motion, *paddle, hit) && hit.time <= earliest.time) {
+				earliest = hit;
+				hitType = PADDLE;
+				hitPaddle = paddle;
+			}
+		}
+
+		// Walls, the playable area is a box the ball center can't leave
+		float wallT;
+		if (motion.x < 0 && position.x + motion.x < minX && (wallT = std::max(0.0f, (minX - position.x) / motion.x)) < earliest.time) {
+			earliest = { wallT, { 1, 0 } }; hitType = WALL_X;
+		}
+		if (motion.x > 0 && position.x + motion.x > maxX && (wallT = std::max(0.0f, (maxX - position.x) / motion.x)) < earliest.time) {
+			earliest = { wallT, { -1, 0 } }; hitType = WALL_X;
+		}
+		if (motion.y < 0 && position.y + motion.y < minY && (wallT = std::max(0.0f, (minY - position.y) / motion.y)) < earliest.time) {
+			earliest = { wallT, { 0, 1 } }; hitType = WALL_Y;
+		}
+		if (motion.y > 0 && position.y + motion.y > maxY && (wallT = std::max(0.0f, (maxY - position.y) / motion.y)) < earliest.time) {
+			earliest = { wallT, { 0, -1 } }; hitType = WALL_Y;
+		}
+
+		if (hitType == NONE) {
+			position.x += motion.x;
+			position.y += motion.y;
+			return bounces;
+		}
+
+		position.x += motion.x * earliest.time;
+		position.y += motion.y * earliest.time;
+		remaining -= remaining * earliest.time;
+		++bounces;
+
+		switch (hitType) {
+		case PADDLE:
+			bounceOffBox(position, speed, *hitPaddle, earliest.normal);
+			break;
+		case WALL_X:
+			position.x = earliest.normal.x > 0 ? minX : maxX; // Snap, so rounding never leaves it outside
+			speed.x = earliest.normal.x * std::fabs(speed.x);
+			break;
+		case WALL_Y:
+			position.y = earliest.normal.y > 0 ? minY : maxY;
+			speed.y = earliest.normal.y * std::fabs(speed.y);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return bounces;
+}
+
+inline int advanceBallSwept(Ball& ball, const Paddle& leftPaddle, const Paddle& rightPaddle, const PlayableRectangle& rect, float deltaTime, int maxBounces = maxSweptBounces) {
+	const SweepBounds bounds{ rect.origin.x + ball.radius, rect.origin.x + rect.dimentions.x - ball.radius,
+							  rect.origin.y + ball.radius, rect.origin.y + rect.dimentions.y - ball.radius };
+	return advanceCircleSwept(ball.position, ball.speed, ball.radius, sweepBoxOf(leftPaddle), sweepBoxOf(rightPaddle), bounds, deltaTime, maxBounces);
+}
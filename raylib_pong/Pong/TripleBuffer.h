@@ -0,0 +1,73 @@
+/*
+Lock-free triple buffer: one thread keeps publishing values, another one reads the newest whenever it wants.
+
+There are three slots. The writer always has one of them to itself (back), the reader too (front), and the third one
+(middle) holds the last published value. Publishing swaps back and middle, reading swaps front and middle if something
+new was published since the last read. Both swaps are a single atomic exchange of a byte holding the middle index and a
+"new value" bit, so neither side ever waits for the other: a slow reader just skips the values it didn't get to, and
+the writer never overwrites the slot being read.
+
+Made for small trivially copyable values (snapshots of a game state), each slot has its own cache line.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+
+template <typename T>
+class TripleBuffer {
+public:
+	explicit TripleBuffer(const T& initial = T{})
+		: slots{ { initial }, { initial }, { initial } } {}
+
+	TripleBuffer(const TripleBuffer&) = delete;
+	TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+	// Writer thread only: the slot to fill before calling publish()
+	T& back() {
+		return slots[backIndex].value;
+	}
+
+	// Writer thread only
+	void publish() {
+		uint8_t previous = middle.exchange(static_cast<uint8_t>(backIndex | freshBit), std::memory_order_acq_rel);
+		backIndex = previous & indexMask;
+	}
+
+	void publish(const T& value) {
+		back() = value;
+		publish();
+	}
+
+	// Reader thread only: moves to the newest published value, false if there's nothing new since the last call
+	bool update() {
+		if (!(middle.load(std::memory_order_relaxed) & freshBit)) return false;
+		uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+		frontIndex = previous & indexMask;
+		return true;
+	}
+
+	// Reader thread only: the value update() moved to, stays the same until the next update()
+	const T& front() const {
+		return slots[frontIndex].value;
+	}
+
+	const T& read() {
+		update();
+		return front();
+	}
+
+private:
+	static constexpr uint8_t indexMask{ 0x3 };
+	static constexpr uint8_t freshBit{ 0x4 };
+
+	struct alignas(64) Slot {
+		T value;
+	};
+
+	Slot slots[3];
+	alignas(64) std::atomic<uint8_t> middle{ 1 };
+	alignas(64) uint8_t backIndex{ 0 }; // Writer side
+	alignas(64) uint8_t frontIndex{ 2 }; // Reader side
+};
@@ -1,178 +1,87 @@
 /*
 	This code is based on Jones' tutorial on YouTube: https://www.youtube.com/watch?v=LvpS3ILwQNA
 */
+#define PROFILER_ENABLED // Before any include, the shared headers check it
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <string>
 
 namespace rl {
 	#include "raylib.h"
 }
 
-struct Vector2 {
-	float x, y;
-};
-
-struct PlayableRectangle {
-	const rl::Vector2 origin;
-	const rl::Vector2 dimentions;
-
-	PlayableRectangle(int originX, int originY, int width, int height)
-		: origin{ static_cast<float>(originX), static_cast<float>(originY) }, dimentions{ static_cast<float>(width), static_cast<float>(height) } {
-	}
-};
-
-struct GameObject {
-	Vector2 position;
-	Vector2 speed;
-
-	GameObject(Vector2 position, Vector2 speed)
-		: position{ position }, speed{ speed } {}
-
-	virtual void keepInsidePlayableArea(const PlayableRectangle& rect) = 0;
-	virtual void positionInPlayableArea(const PlayableRectangle& rect) = 0;
-	virtual void updatePosition(float timeDelta) = 0;
-};
-
-struct Paddle : GameObject{
-	enum PaddleType {
-		LEFT = 0,
-		RIGHT
-	} type;
-
-	float width, height;
-
-	Paddle(int width, int height, PaddleType type, float speed = 1)
-		: width{ static_cast<float>(width) }, height{ static_cast<float>(height) }, type{ type }, GameObject { {0.0, 0.0}, { 0.0, speed }} {}
-
-	// Another way we can do this and the ball too, is having a "positioner" class that will take care of the positioning of the objects
-	void positionInPlayableArea(const PlayableRectangle& rect) override {
-		switch (type) {
-		case PaddleType::RIGHT:
-			position.x = rect.origin.x + rect.dimentions.x - (0.0625 * rect.dimentions.x) - width/2;
-			break;
-		case PaddleType::LEFT:
-		default:
-			position.x = rect.origin.x + (0.0625 * rect.dimentions.x) + width/2;
-		}
-		position.y = rect.origin.y + rect.dimentions.y / 2;
-	}
-
-	void keepInsidePlayableArea(const PlayableRectangle& rect) override {
-		// Check y axis only, paddle can't mode in x axis
-		// Top edge
-		if (position.y - height/2 < rect.origin.y) {
-			position.y = rect.origin.y + height/2;
-			//speed.y *= -1; // Leaving this creates a funny behavior, try it out. It's not a bug it's a feature
-		}
-		// Bottom edge
-		if (position.y + height/2 > rect.origin.y + rect.dimentions.y) {
-			position.y = rect.origin.y + rect.dimentions.y - height/2;
-			//speed.y *= - 1; // Leaving this creates a funny behavior, try it out. It's not a bug it's a feature
-		}
-	}
-
-	void updatePosition(float deltaTime) override {
-		position.y += speed.y * deltaTime;
-	}
-};
-
-struct Ball : GameObject {
-	float radius;
-
-	Ball(int radiusInPixels, float speedX = 0.0, float speedY = 0.0)
-		: radius{ static_cast<float>(radiusInPixels) }, GameObject{ {0.0, 0.0}, {speedX, speedY} } {}
+#include "../../common/CommandLine.h"
+#include "../../raylib_common/ProfilerOverlay.h"
+#include "MultiBallWorld.h"
+#include "PongCore.h"
+#include "PongGameHeadless.h"
+#include "PongSimulationThread.h"
+#include "Replay.h"
 
-	void positionInPlayableArea(const PlayableRectangle& rect) override {
-		position.x = (rect.origin.x + rect.dimentions.x) / 2.0;
-		position.y = (rect.origin.y + rect.dimentions.y) / 2.0;
-	}
-
-	void keepInsidePlayableArea(const PlayableRectangle& rect) override {
-		// Check xAxis
-		if (position.x - radius < rect.origin.x) {
-			position.x = rect.origin.x + radius;
-			speed.x *= -1;
-		}
-		if (position.x + radius > rect.origin.x + rect.dimentions.x) {
-			position.x = rect.origin.x + rect.dimentions.x - radius;
-			speed.x *= -1;
-		}
-		if (position.y - radius < rect.origin.y) {
-			position.y = rect.origin.y + radius;
-			speed.y *= -1;
-		}
-		if (position.y + radius > rect.origin.y + rect.dimentions.y) {
-			position.y = rect.origin.y + rect.dimentions.y - radius;
-			speed.y *= -1;
-		}
-	}
-
-	void handleCollisionWithPaddle(const Paddle& paddle) {
-		if (paddle.type == Paddle::LEFT) position.x = paddle.position.x + paddle.width / 2 + radius;
-		else position.x = paddle.position.x - paddle.width / 2 - radius;
-
-		speed.x *= -1;
-		speed.y = 500 * (position.y - paddle.position.y) / paddle.height / 2;
-	}
-
-	void updatePosition(float deltaTime) override {
-		position.x += speed.x * deltaTime;
-		position.y += speed.y * deltaTime;
+// The single threaded desktop game is the headless simulation plus a window, the keyboard and a fixed time step clock.
+// Replays and --single-thread use it, normal games run the simulation on its own thread (runThreaded)
+struct PongGameDesktop : PongGameHeadless {
+	static constexpr float maxFrameSeconds{ 1.0f / 12.0f }; // Longest frame the steps catch up with, a slower one plays in slow motion
 
-		// Here I could do bound checking
-	}
-};
-
-struct PongGame {
-	const PlayableRectangle& gameArea;
-	Ball& ball;
-	Paddle& leftPaddle;
-	Paddle& rightPaddle;
+	float accumulator{ 0 };
+	ReplayRecorder* recorder{ nullptr };
+	ReplayPlayer* player{ nullptr };
+	float playbackSpeed{ 1 };
+	bool showProfiler{ false };
 
-	PongGame(const PlayableRectangle& gameArea, Ball& ball, Paddle& leftPaddle, Paddle& rightPaddle)
-		: gameArea(gameArea), ball(ball), leftPaddle(leftPaddle), rightPaddle(rightPaddle) {}
-
-	virtual void initialize() = 0;
-	virtual void update() = 0;
-	virtual void render() = 0;
-	virtual bool end() = 0;
-	virtual void close() = 0;
-
-private:
-	virtual void manageCollitions() = 0;
-	virtual void constrainGameObjectsToGameArea() = 0;
-};
-
-struct PongGameDesktop : PongGame{
-	PongGameDesktop(const PlayableRectangle& gameArea, Ball& ball, Paddle& leftPaddle, Paddle& rightPaddle)
-		: PongGame{gameArea, ball, leftPaddle, rightPaddle} {}
+	PongGameDesktop(const PlayableRectangle& gameArea, Ball& ball, Paddle& leftPaddle, Paddle& rightPaddle, float timeStep = 1.0f / 120.0f)
+		: PongGameHeadless{gameArea, ball, leftPaddle, rightPaddle, timeStep} {}
 
 	void initialize() override {
 		rl::InitWindow(gameArea.dimentions.x, gameArea.dimentions.y, "Pong"); // First create an application window
 		rl::SetWindowState(rl::FLAG_VSYNC_HINT); // Turn V-sync on
 
-		ball.positionInPlayableArea(gameArea);
-		leftPaddle.positionInPlayableArea(gameArea);
-		rightPaddle.positionInPlayableArea(gameArea);
+		PongGameHeadless::initialize();
 	}
 
 	void update() override {
-		// Update paddle speeds
-		if (rl::IsKeyDown(rl::KEY_W)) leftPaddle.speed.y = (leftPaddle.speed.y > 0) ? -leftPaddle.speed.y : leftPaddle.speed.y;
-		if (rl::IsKeyDown(rl::KEY_S)) leftPaddle.speed.y = (leftPaddle.speed.y > 0) ? leftPaddle.speed.y : -leftPaddle.speed.y;
-		if (rl::IsKeyDown(rl::KEY_UP)) rightPaddle.speed.y = (rightPaddle.speed.y > 0) ? -rightPaddle.speed.y : rightPaddle.speed.y;
-		if (rl::IsKeyDown(rl::KEY_DOWN)) rightPaddle.speed.y = (rightPaddle.speed.y > 0) ? rightPaddle.speed.y : -rightPaddle.speed.y;
+		PROFILE_SCOPE("update");
 
-		// Update positions
-		ball.updatePosition(rl::GetFrameTime());
-		if (rl::IsKeyDown(rl::KEY_W) || rl::IsKeyDown(rl::KEY_S)) leftPaddle.updatePosition(rl::GetFrameTime());
-		if (rl::IsKeyDown(rl::KEY_UP) || rl::IsKeyDown(rl::KEY_DOWN)) rightPaddle.updatePosition(rl::GetFrameTime());
+		// F1 shows the per phase timings, F2 dumps the recorded phases as Chrome trace JSON
+		if (rl::IsKeyPressed(rl::KEY_F1)) showProfiler = !showProfiler;
+		if (rl::IsKeyPressed(rl::KEY_F2)) Profiler::dumpChromeTrace("pong_trace.json");
 
-		manageCollitions(); // ball-paddle collitions
+		// The frame time only decides how many fixed steps to run, the simulation never sees it. That's what makes replays bit-exact
+		accumulator += rl::GetFrameTime() * (player ? playbackSpeed : 1.0f);
 
-		constrainGameObjectsToGameArea();
+		if (player) handleReplayKeys();
+		else {
+			// Update paddle inputs (S and DOWN win if both keys are pressed, same as before)
+			leftInput = rl::IsKeyDown(rl::KEY_S) ? 1 : (rl::IsKeyDown(rl::KEY_W) ? -1 : 0);
+			rightInput = rl::IsKeyDown(rl::KEY_DOWN) ? 1 : (rl::IsKeyDown(rl::KEY_UP) ? -1 : 0);
+		}
+
+		// The cap comes from the time step, a replay recorded at 1000 Hz runs about 17 steps per 60 Hz frame
+		int maxSteps = static_cast<int>(std::ceil(maxFrameSeconds / timeStep) * std::ceil(player ? std::max(playbackSpeed, 1.0f) : 1.0f));
+		int steps{ 0 };
+		while (accumulator >= timeStep && steps < maxSteps) {
+			if (player) {
+				if (!player->step()) break;
+			}
+			else {
+				PongGameHeadless::update();
+				if (recorder) recorder->recordStep(leftInput, rightInput, *this);
+			}
+			accumulator -= timeStep;
+			++steps;
+		}
+		// Too far behind: keep at most one more frame's worth of steps, catching up with everything could never end
+		if (steps == maxSteps) accumulator = std::min(accumulator, maxSteps * timeStep);
 	}
 
 	void render() override {
+		PROFILE_SCOPE("render");
+
 		// Draw on screen
 		rl::BeginDrawing();
 			rl::ClearBackground(rl::RAYWHITE);
@@ -180,6 +89,10 @@ struct PongGameDesktop : PongGame{
 			rl::DrawRectangle((int)(leftPaddle.position.x - leftPaddle.width / 2), (int)(leftPaddle.position.y - leftPaddle.height / 2), (int)leftPaddle.width, (int)leftPaddle.height, rl::BLACK);
 			rl::DrawRectangle((int)(rightPaddle.position.x - rightPaddle.width / 2), (int)(rightPaddle.position.y - rightPaddle.height / 2), (int)rightPaddle.width, (int)rightPaddle.height, rl::BLACK);
 			rl::DrawFPS(5, 5);
+			if (player) {
+				rl::DrawText(rl::TextFormat("Replay %llu/%llu x%.2f desyncs: %d", (unsigned long long)player->currentStep(), (unsigned long long)player->stepCount(), playbackSpeed, player->desyncCount()), 5, 25, 20, rl::DARKGRAY);
+			}
+			if (showProfiler) drawProfilerOverlay(5, 50);
 		rl::EndDrawing();
 	}
 
@@ -192,41 +105,209 @@ struct PongGameDesktop : PongGame{
 	}
 
 private:
-	void manageCollitions() override {
-		if (checkBallCollisionWithPaddle(Paddle::LEFT)) handleBallCollisionWithPaddle(Paddle::LEFT);
-		if (checkBallCollisionWithPaddle(Paddle::RIGHT)) handleBallCollisionWithPaddle(Paddle::RIGHT);
+	// LEFT/RIGHT seek 10 seconds, UP/DOWN change the playback speed
+	void handleReplayKeys() {
+		uint64_t tenSeconds = static_cast<uint64_t>(10.0f / timeStep);
+		if (rl::IsKeyPressed(rl::KEY_RIGHT)) player->seek(player->currentStep() + tenSeconds);
+		if (rl::IsKeyPressed(rl::KEY_LEFT)) player->seek(player->currentStep() > tenSeconds ? player->currentStep() - tenSeconds : 0);
+		if (rl::IsKeyPressed(rl::KEY_UP)) playbackSpeed *= 2;
+		if (rl::IsKeyPressed(rl::KEY_DOWN)) playbackSpeed /= 2;
 	}
+};
+
+// Stress mode: the same paddles and keys, thousands of balls colliding with each other (see MultiBallWorld)
+int runMultiBall(const PlayableRectangle& gameArea, int ballCount) {
+	const float timeStep{ 1.0f / 120.0f };
+	const float radius{ 3 };
 
-	bool checkBallCollisionWithPaddle(Paddle::PaddleType paddleType) {
-		Paddle& paddle = (paddleType == Paddle::LEFT) ? leftPaddle : rightPaddle;
+	Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
+	Paddle rightPaddle{ 10, 100, Paddle::RIGHT, 500 };
+	leftPaddle.positionInPlayableArea(gameArea);
+	rightPaddle.positionInPlayableArea(gameArea);
+
+	MultiBallWorld world{ gameArea, leftPaddle, rightPaddle, radius };
+	world.spawnRandomBalls(ballCount, radius, 100.0f, 300.0f, 1234);
+
+	rl::InitWindow(gameArea.dimentions.x, gameArea.dimentions.y, "Pong - multiball");
+	rl::SetWindowState(rl::FLAG_VSYNC_HINT);
+
+	const int maxSteps = static_cast<int>(std::ceil(PongGameDesktop::maxFrameSeconds / timeStep));
+	float accumulator{ 0 };
+	bool showProfiler{ false };
+	while (!rl::WindowShouldClose()) {
+		{
+			PROFILE_SCOPE("update");
+			if (rl::IsKeyPressed(rl::KEY_F1)) showProfiler = !showProfiler;
+			if (rl::IsKeyPressed(rl::KEY_F2)) Profiler::dumpChromeTrace("pong_trace.json");
+			if (rl::IsKeyPressed(rl::KEY_SPACE)) world.broadphase = (world.broadphase == MultiBallWorld::Broadphase::GRID) ? MultiBallWorld::Broadphase::PAIRWISE : MultiBallWorld::Broadphase::GRID;
+
+			int leftInput = rl::IsKeyDown(rl::KEY_S) ? 1 : (rl::IsKeyDown(rl::KEY_W) ? -1 : 0);
+			int rightInput = rl::IsKeyDown(rl::KEY_DOWN) ? 1 : (rl::IsKeyDown(rl::KEY_UP) ? -1 : 0);
+
+			accumulator += rl::GetFrameTime();
+			int steps{ 0 };
+			while (accumulator >= timeStep && steps < maxSteps) {
+				if (leftInput != 0) leftPaddle.position.y += leftInput * std::fabs(leftPaddle.speed.y) * timeStep;
+				if (rightInput != 0) rightPaddle.position.y += rightInput * std::fabs(rightPaddle.speed.y) * timeStep;
+				leftPaddle.keepInsidePlayableArea(gameArea);
+				rightPaddle.keepInsidePlayableArea(gameArea);
+
+				world.step(timeStep);
+				accumulator -= timeStep;
+				++steps;
+			}
+			if (steps == maxSteps) accumulator = 0; // Stress mode, a slow frame is dropped instead of caught up with
+		}
 
-		return rl::CheckCollisionCircleRec(rl::Vector2{ ball.position.x, ball. position.y }, ball.radius,
-			rl::Rectangle{ paddle.position.x - paddle.width / 2,
-						   paddle.position.y - paddle.height / 2,
-						   paddle.width,
-						   paddle.height });
+		{
+			PROFILE_SCOPE("render");
+			rl::BeginDrawing();
+				rl::ClearBackground(rl::RAYWHITE);
+				for (const Ball& ball : world.balls)
+					rl::DrawCircle(ball.position.x, ball.position.y, ball.radius, rl::BLACK);
+				rl::DrawRectangle((int)(leftPaddle.position.x - leftPaddle.width / 2), (int)(leftPaddle.position.y - leftPaddle.height / 2), (int)leftPaddle.width, (int)leftPaddle.height, rl::BLACK);
+				rl::DrawRectangle((int)(rightPaddle.position.x - rightPaddle.width / 2), (int)(rightPaddle.position.y - rightPaddle.height / 2), (int)rightPaddle.width, (int)rightPaddle.height, rl::BLACK);
+				rl::DrawFPS(5, 5);
+				rl::DrawText(rl::TextFormat("%d balls, %s broadphase (SPACE switches)", ballCount, world.broadphase == MultiBallWorld::Broadphase::GRID ? "grid" : "pairwise"), 5, 25, 20, rl::DARKGRAY);
+				if (showProfiler) drawProfilerOverlay(5, 50);
+			rl::EndDrawing();
+		}
+
+		Profiler::endFrame();
 	}
 
-	void handleBallCollisionWithPaddle(Paddle::PaddleType type) {
-		Paddle& paddle = (type == Paddle::LEFT) ? leftPaddle : rightPaddle;
-		float xOffset = (type == Paddle::LEFT) ? paddle.width / 2 + ball.radius : -paddle.width / 2 - ball.radius;
+	rl::CloseWindow();
+	return 0;
+}
+
+/*
+	The simulation ticks on its own thread (see PongSimulationThread), this thread only reads the keys and draws. V-sync
+	stays on, it only limits how often the game is drawn now.
+*/
+int runThreaded(const PlayableRectangle& gameArea, float tickRate, const char* recordFile) {
+	// Simulation objects, only the simulation thread touches them once it starts
+	Ball ball{ 5, -500 };
+	Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
+	Paddle rightPaddle{ 10, 100, Paddle::RIGHT, 500 };
+	PongGameHeadless game{ gameArea, ball, leftPaddle, rightPaddle, 1.0f / tickRate };
+	game.initialize();
 
-		ball.position.x = paddle.position.x + xOffset;
-		ball.speed.x *= -1;
-		ball.speed.y = 500 * (ball.position.y - paddle.position.y) / paddle.height / 2;
+	std::unique_ptr<ReplayRecorder> recorder;
+	try {
+		if (recordFile) recorder = std::make_unique<ReplayRecorder>(recordFile, game, game.timeStep);
 	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		return 1;
+	}
+
+	// Copies for drawing, the published states move them
+	Ball drawnBall = ball;
+	Paddle drawnLeftPaddle = leftPaddle;
+	Paddle drawnRightPaddle = rightPaddle;
+
+	rl::InitWindow(gameArea.dimentions.x, gameArea.dimentions.y, "Pong");
+	rl::SetWindowState(rl::FLAG_VSYNC_HINT);
+
+	PongSimulationThread simulation{ game, recorder.get() };
+	simulation.start();
+
+	PongInput sent;
+	bool showProfiler{ false };
+	double rateStart = simulation.secondsSinceStart();
+	uint64_t rateStartTicks{ 0 };
+	double measuredTickRate{ 0 };
+	while (!rl::WindowShouldClose()) {
+		{
+			PROFILE_SCOPE("input");
+			if (rl::IsKeyPressed(rl::KEY_F1)) showProfiler = !showProfiler;
+			if (rl::IsKeyPressed(rl::KEY_F2)) Profiler::dumpChromeTrace("pong_trace.json");
+
+			// Same keys as PongGameDesktop, only sent when they change. A full queue keeps `sent` as it was so it's tried again
+			PongInput input{ static_cast<int8_t>(rl::IsKeyDown(rl::KEY_S) ? 1 : (rl::IsKeyDown(rl::KEY_W) ? -1 : 0)),
+							 static_cast<int8_t>(rl::IsKeyDown(rl::KEY_DOWN) ? 1 : (rl::IsKeyDown(rl::KEY_UP) ? -1 : 0)) };
+			if (input != sent && simulation.sendInput(input)) sent = input;
+		}
+
+		{
+			PROFILE_SCOPE("render");
+			PongSnapshot state = simulation.stateToRender();
+			drawnBall.position = state.ballPosition;
+			drawnLeftPaddle.position = state.leftPaddlePosition;
+			drawnRightPaddle.position = state.rightPaddlePosition;
+
+			double now = simulation.secondsSinceStart();
+			if (now - rateStart >= 1.0) {
+				uint64_t ticks = simulation.tickCount();
+				measuredTickRate = (ticks - rateStartTicks) / (now - rateStart);
+				rateStart = now;
+				rateStartTicks = ticks;
+			}
+
+			rl::BeginDrawing();
+				rl::ClearBackground(rl::RAYWHITE);
+				rl::DrawCircle(drawnBall.position.x, drawnBall.position.y, drawnBall.radius, rl::BLACK);
+				rl::DrawRectangle((int)(drawnLeftPaddle.position.x - drawnLeftPaddle.width / 2), (int)(drawnLeftPaddle.position.y - drawnLeftPaddle.height / 2), (int)drawnLeftPaddle.width, (int)drawnLeftPaddle.height, rl::BLACK);
+				rl::DrawRectangle((int)(drawnRightPaddle.position.x - drawnRightPaddle.width / 2), (int)(drawnRightPaddle.position.y - drawnRightPaddle.height / 2), (int)drawnRightPaddle.width, (int)drawnRightPaddle.height, rl::BLACK);
+				rl::DrawFPS(5, 5);
+				rl::DrawText(rl::TextFormat("Simulation %.0f ticks/s", measuredTickRate), 5, 25, 20, rl::DARKGRAY);
+				if (showProfiler) drawProfilerOverlay(5, 50);
+			rl::EndDrawing();
+		}
 
-	void constrainGameObjectsToGameArea() override {
-		ball.keepInsidePlayableArea(gameArea);
-		leftPaddle.keepInsidePlayableArea(gameArea);
-		rightPaddle.keepInsidePlayableArea(gameArea);
+		Profiler::endFrame(); // Takes the ticks the simulation thread ran during the frame too
 	}
-};
 
-int main() {
+	simulation.stop();
+	if (recorder) recorder->close();
+	rl::CloseWindow();
+	return 0;
+}
+
+/*
+	Usage:
+		Pong [--tick-rate <hz>]                  play, the simulation ticks 1000 times per second on its own thread by default
+		Pong --record <file> [--tick-rate <hz>]  play and record the match
+		Pong --single-thread [--record <file>]   simulation and drawing on the same thread, 120 ticks per second
+		Pong --replay <file> [speed]             watch a recorded match
+		Pong --multiball [balls = 2000]          stress mode, balls collide with each other too
+*/
+int main(int argc, char* argv[]) {
 	// Window set-up
 	const PlayableRectangle gameArea{ 0, 0, 800, 600 };
 
+	if (argc > 1 && std::strcmp(argv[1], "--multiball") == 0) {
+		int ballCount{ 2000 };
+		if (argc > 2 && !parsePositive(argv[2], ballCount)) {
+			std::cerr << "Error: the ball count has to be a positive integer\n";
+			return 1;
+		}
+		return runMultiBall(gameArea, ballCount);
+	}
+
+	const char* recordFile{ nullptr };
+	const char* replayFile{ nullptr };
+	float playbackSpeed{ 1 };
+	float tickRate{ 1000 };
+	bool singleThread{ false };
+	for (int i{ 1 }; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordFile = argv[++i];
+		else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+			replayFile = argv[++i];
+			if (i + 1 < argc && argv[i + 1][0] != '-') playbackSpeed = static_cast<float>(std::atof(argv[++i]));
+		}
+		else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) tickRate = static_cast<float>(std::atof(argv[++i]));
+		else if (std::strcmp(argv[i], "--single-thread") == 0) singleThread = true;
+	}
+
+	if (!replayFile && !singleThread) {
+		if (tickRate <= 0) {
+			std::cerr << "Error: the tick rate has to be positive\n";
+			return 1;
+		}
+		return runThreaded(gameArea, tickRate, recordFile);
+	}
+
 	// Initialize components
 	Ball ball{ 5, -500 };
 	Paddle leftPaddle{ 10, 100, Paddle::LEFT, 500 };
@@ -236,12 +317,34 @@ int main() {
 
 	game.initialize();
 
+	std::unique_ptr<ReplayRecorder> recorder;
+	std::unique_ptr<ReplayPlayer> player;
+	try {
+		if (replayFile) {
+			player = std::make_unique<ReplayPlayer>(replayFile, game);
+			game.player = player.get();
+			game.playbackSpeed = playbackSpeed;
+		}
+		else if (recordFile) {
+			recorder = std::make_unique<ReplayRecorder>(recordFile, game, game.timeStep);
+			game.recorder = recorder.get();
+		}
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error: " << e.what() << std::endl;
+		game.close();
+		return 1;
+	}
+
 	while (!game.end()) {
 		game.update();
 
 		game.render();
+
+		Profiler::endFrame();
 	}
 
+	if (recorder) recorder->close();
 	game.close();
 	return 0;
 }
\ No newline at end of file
@@ -1,11 +1,163 @@
-#include <stack>
+/*
+	Snake on top of SnakeCore.h (ring buffer body + bitset occupancy grid). Usage below, it's also printed for bad arguments.
+*/
+#define PROFILER_ENABLED // Before any include, the shared headers check it
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <random>
 
 namespace rl {
 #include "raylib.h"
 }
 
-int main() {
-	
+#include "../common/CommandLine.h"
+#include "../raylib_common/ProfilerOverlay.h"
+#include "SnakeAutoplayer.h"
+#include "SnakeCore.h"
+
+static const char* const usage =
+	"Usage:\n"
+	"  Snake                                            play (arrows or WASD, R restarts, P toggles the autoplayer, F1 shows the profiler)\n"
+	"  Snake --headless [width height ticks = 10000000]  random turns without a window, prints ticks/s\n"
+	"  Snake --autoplay [width height ticks = 10000000]  same with the autoplayer driving\n"
+	"The board needs both sides >= 2, --autoplay also one even side. ticks has to be at least 1.\n";
+
+struct SnakeDesktop {
+	static constexpr int cellSize{ 20 };
+	static constexpr float tickTime{ 0.1f }; // Seconds per move
+
+	SnakeGame game;
+	SnakeAutoplayer autoplayer{ game };
+	float accumulator{ 0 };
+	bool showProfiler{ false };
+	bool autoplay{ false };
+
+	SnakeDesktop(int width, int height)
+		: game{ width, height } {}
+
+	void initialize() {
+		rl::InitWindow(game.getGrid().getWidth() * cellSize, game.getGrid().getHeight() * cellSize, "Snake");
+		rl::SetWindowState(rl::FLAG_VSYNC_HINT);
+	}
+
+	void update() {
+		PROFILE_SCOPE("update");
+
+		if (rl::IsKeyPressed(rl::KEY_F1)) showProfiler = !showProfiler;
+		if (rl::IsKeyPressed(rl::KEY_F2)) Profiler::dumpChromeTrace("snake_trace.json");
+		if (rl::IsKeyPressed(rl::KEY_R)) game.reset();
+		if (rl::IsKeyPressed(rl::KEY_P)) autoplay = !autoplay;
+
+		if (rl::IsKeyPressed(rl::KEY_UP) || rl::IsKeyPressed(rl::KEY_W)) game.setDirection(SnakeGame::UP);
+		if (rl::IsKeyPressed(rl::KEY_DOWN) || rl::IsKeyPressed(rl::KEY_S)) game.setDirection(SnakeGame::DOWN);
+		if (rl::IsKeyPressed(rl::KEY_LEFT) || rl::IsKeyPressed(rl::KEY_A)) game.setDirection(SnakeGame::LEFT);
+		if (rl::IsKeyPressed(rl::KEY_RIGHT) || rl::IsKeyPressed(rl::KEY_D)) game.setDirection(SnakeGame::RIGHT);
+
+		// Same fixed step clock as Pong, the frame rate doesn't change the game speed
+		accumulator += rl::GetFrameTime();
+		while (accumulator >= tickTime) {
+			PROFILE_SCOPE("tick");
+			if (autoplay) game.setDirection(autoplayer.nextMove());
+			game.tick();
+			accumulator -= tickTime;
+		}
+	}
+
+	void render() {
+		PROFILE_SCOPE("render");
+
+		rl::BeginDrawing();
+			rl::ClearBackground(rl::RAYWHITE);
+
+			Cell food = game.getFood();
+			if (food.x >= 0) rl::DrawRectangle(food.x * cellSize, food.y * cellSize, cellSize, cellSize, rl::RED);
+
+			const OccupancyGrid& grid = game.getGrid();
+			const RingBuffer<uint32_t>& body = game.getBody();
+			for (size_t i{ 0 }; i < body.size(); ++i) {
+				Cell cell = grid.cellAt(body[i]);
+				rl::DrawRectangle(cell.x * cellSize + 1, cell.y * cellSize + 1, cellSize - 2, cellSize - 2, (i + 1 == body.size()) ? rl::DARKGREEN : rl::GREEN);
+			}
+
+			if (game.getState() == SnakeGame::State::DEAD) rl::DrawText("Game over, R to restart", 10, 30, 20, rl::MAROON);
+			if (game.getState() == SnakeGame::State::WON) rl::DrawText("You win! R to restart", 10, 30, 20, rl::DARKGREEN);
+			rl::DrawText(rl::TextFormat("Length: %d%s", static_cast<int>(game.length()), autoplay ? " (autoplay)" : ""), 10, 55, 20, rl::DARKGRAY);
+			rl::DrawFPS(5, 5);
+			if (showProfiler) drawProfilerOverlay(5, 80);
+		rl::EndDrawing();
+	}
 
+	bool end() {
+		return rl::WindowShouldClose();
+	}
+
+	void close() {
+		rl::CloseWindow();
+	}
+};
+
+// Random turns (or the autoplayer), restarting when a game ends. Only measures the game logic
+int runHeadless(int width, int height, uint64_t ticks, bool autoplay) {
+	SnakeGame game{ width, height, 1234 };
+	std::optional<SnakeAutoplayer> autoplayer; // Only when asked for, it needs a board with an even side
+	if (autoplay) autoplayer.emplace(game);
+	std::mt19937 rng{ 1234 };
+	std::uniform_int_distribution<int> turn{ 0, 7 }; // Mostly keep going, turn now and then
+
+	uint64_t games{ 1 };
+	auto start = std::chrono::steady_clock::now();
+	for (uint64_t t{ 0 }; t < ticks; ++t) {
+		if (autoplayer) game.setDirection(autoplayer->nextMove());
+		else {
+			int roll = turn(rng);
+			if (roll < 4) game.setDirection(static_cast<SnakeGame::Direction>(roll));
+		}
+		if (game.tick() != SnakeGame::State::PLAYING) {
+			game.reset();
+			++games;
+		}
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << ticks << " ticks on a " << width << "x" << height << " board (" << games << " games) in " << seconds << " s, "
+		<< ticks / seconds << " ticks/s" << std::endl;
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && (std::strcmp(argv[1], "--headless") == 0 || std::strcmp(argv[1], "--autoplay") == 0)) {
+		int width{ 32 }, height{ 24 };
+		uint64_t ticks{ 10000000 };
+		bool autoplay = std::strcmp(argv[1], "--autoplay") == 0;
+		bool validNumbers = (argc <= 2 || parsePositive(argv[2], width)) && (argc <= 3 || parsePositive(argv[3], height))
+			&& (argc <= 4 || parsePositive(argv[4], ticks));
+		if (!validNumbers || width < 2 || height < 2) {
+			std::cerr << usage;
+			return 1;
+		}
+		if (autoplay && width % 2 != 0 && height % 2 != 0) {
+			std::cerr << "Error: the autoplayer follows a Hamiltonian cycle, it needs a board with an even side (" << width << "x" << height << " has none)\n";
+			return 1;
+		}
+		return runHeadless(width, height, ticks, autoplay);
+	}
+
+	SnakeDesktop snake{ 32, 24 };
+
+	snake.initialize();
+
+	while (!snake.end()) {
+		snake.update();
+
+		snake.render();
+
+		Profiler::endFrame();
+	}
+
+	snake.close();
 	return 0;
-}
\ No newline at end of file
+}
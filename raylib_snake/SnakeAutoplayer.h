@@ -0,0 +1,258 @@
+/*
+	Snake autoplayer: shortest path to the food, with a Hamiltonian cycle as the fallback that guarantees it fills the board.
+
+	Pathfinding is a BFS from the food over the occupancy grid bitset, 64 cells per instruction: a whole BFS layer is the
+	previous layer shifted one cell in each direction (1 bit sideways, `width` bits up/down), minus the visited and blocked
+	cells. Only the words around the rows the frontier covers are touched. Once a layer reaches a cell next to the head the
+	path is read back from the stored layers, and it is followed until the food moves or the snake leaves it, so there's
+	one BFS per food instead of one per move.
+
+	The cycle visits every cell once. Following it can't fail: the body always lies inside the stretch of the cycle from the
+	tail to the head, everything ahead of the head is free. The BFS move is only taken when it is a shortcut that keeps that
+	true (it lands ahead of the head and leaves enough free cells before the tail for the growth still pending), otherwise
+	the snake just takes the next cell of the cycle. Shortcuts stop once the snake covers half the board, from there on it
+	only closes the gaps the shortcuts left.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "SnakeCore.h"
+
+// Next direction along a Hamiltonian cycle: rows zig-zag from column 1 and column 0 is the way back up. Needs an even height
+inline SnakeGame::Direction rowCycleDirection(Cell cell, int width, int height) {
+	if (cell.x == 0) return cell.y > 0 ? SnakeGame::UP : SnakeGame::RIGHT;
+	if (cell.y % 2 == 0) return cell.x < width - 1 ? SnakeGame::RIGHT : SnakeGame::DOWN;
+	if (cell.x > 1) return SnakeGame::LEFT;
+	return cell.y < height - 1 ? SnakeGame::DOWN : SnakeGame::LEFT;
+}
+
+// Same cycle for any board with an even side (a board with both sides odd has no Hamiltonian cycle)
+inline SnakeGame::Direction hamiltonianCycleDirection(Cell cell, int width, int height) {
+	if (width < 2 || height < 2 || (width % 2 != 0 && height % 2 != 0))
+		throw std::invalid_argument("A Hamiltonian cycle needs both sides >= 2 and one of them even");
+
+	if (height % 2 == 0) return rowCycleDirection(cell, width, height);
+
+	// Odd height, even width: the same cycle transposed
+	switch (rowCycleDirection({ cell.y, cell.x }, height, width)) {
+	case SnakeGame::UP: return SnakeGame::LEFT;
+	case SnakeGame::DOWN: return SnakeGame::RIGHT;
+	case SnakeGame::LEFT: return SnakeGame::UP;
+	case SnakeGame::RIGHT:
+	default: return SnakeGame::DOWN;
+	}
+}
+
+class SnakeAutoplayer {
+public:
+	explicit SnakeAutoplayer(const SnakeGame& game)
+		: game{ game }, width{ game.getGrid().getWidth() }, height{ game.getGrid().getHeight() } {
+		const OccupancyGrid& grid = game.getGrid();
+		size_t words = grid.getWords().size();
+		cellCount = grid.cellCount();
+
+		// Position of every cell along the cycle
+		cycleOrder.resize(cellCount);
+		Cell cell{ 0, 0 };
+		for (uint32_t position{ 0 }; position < cellCount; ++position) {
+			cycleOrder[grid.index(cell)] = position;
+			cell = SnakeGame::neighbor(cell, hamiltonianCycleDirection(cell, width, height));
+		}
+
+		// Masks that drop the bits that wrapped to the next/previous row when shifting sideways
+		notFirstColumn.assign(words, 0);
+		notLastColumn.assign(words, 0);
+		for (size_t i{ 0 }; i < cellCount; ++i) {
+			int x = static_cast<int>(i % width);
+			if (x != 0) notFirstColumn[i >> 6] |= uint64_t{ 1 } << (i & 63);
+			if (x != width - 1) notLastColumn[i >> 6] |= uint64_t{ 1 } << (i & 63);
+		}
+
+		visited.assign(words, 0);
+		frontier.assign(words, 0);
+		next.assign(words, 0);
+	}
+
+	SnakeGame::Direction nextMove() {
+		Cell head = game.head();
+		SnakeGame::Direction cycleMove = hamiltonianCycleDirection(head, width, height);
+		if (game.length() * 2 > cellCount || game.getFood().x < 0) return cycleMove;
+
+		// A planned path stays good while the snake follows it to the same food: the only cells that change meanwhile are
+		// tail cells being freed, which can't block it
+		if (path.empty() || pathFood != game.getFood() || pathStart != head) {
+			if (!planPath(cycleMove)) return cycleMove;
+		}
+
+		SnakeGame::Direction move = path.back();
+		Cell target = SnakeGame::neighbor(head, move);
+		if (!isSafeShortcut(target)) {
+			path.clear();
+			return cycleMove;
+		}
+		path.pop_back();
+		pathStart = target;
+		return move;
+	}
+
+	// Cells along the cycle from `from` to `to`
+	size_t cycleDistance(Cell from, Cell to) const {
+		const OccupancyGrid& grid = game.getGrid();
+		uint32_t a = cycleOrder[grid.index(from)], b = cycleOrder[grid.index(to)];
+		return b >= a ? b - a : b + cellCount - a;
+	}
+
+private:
+	const SnakeGame& game;
+	int width, height;
+	size_t cellCount;
+	std::vector<uint32_t> cycleOrder;
+	std::vector<uint64_t> notFirstColumn, notLastColumn;
+	std::vector<uint64_t> visited, frontier, next;
+
+	// Every BFS layer, the words [first, last) of it stored from `offset` in layerBits
+	struct Layer { long long first, last; size_t offset; };
+	std::vector<Layer> layers;
+	std::vector<uint64_t> layerBits;
+
+	std::vector<SnakeGame::Direction> path; // Moves to the food, the next one at the back
+	Cell pathFood{ -1, -1 }, pathStart{ -1, -1 };
+
+	bool isSafeShortcut(Cell target) const {
+		Cell head = game.head();
+		size_t ahead = cycleDistance(head, target);
+		size_t freeAhead = (game.length() == 1) ? cellCount : cycleDistance(head, game.tail());
+		if (ahead == 0 || ahead >= freeAhead) return false; // Behind the head or past the tail
+
+		// Jumping over the food along the cycle would mean a whole lap to get back to it
+		size_t foodAhead = cycleDistance(head, game.getFood());
+		if (foodAhead < freeAhead && ahead > foodAhead) return false;
+
+		// What's left before the tail has to hold the pending growth (plus the food it might eat on the way)
+		size_t left = freeAhead - ahead;
+		return left > static_cast<size_t>(game.getPendingGrowth() + 2 * SnakeGame::growthPerFood + 1);
+	}
+
+	// Word `word` of the multiword shift of `source` by `bits` (towards higher cell indices if positive)
+	static uint64_t shiftedWord(const std::vector<uint64_t>& source, long long word, long long bits) {
+		long long wordShift = (bits >= 0 ? bits : -bits) / 64;
+		int bitShift = static_cast<int>((bits >= 0 ? bits : -bits) % 64);
+		long long size = static_cast<long long>(source.size());
+		auto at = [&](long long i) { return (i >= 0 && i < size) ? source[i] : 0; };
+
+		if (bits >= 0) {
+			uint64_t value = at(word - wordShift) << bitShift;
+			if (bitShift != 0) value |= at(word - wordShift - 1) >> (64 - bitShift);
+			return value;
+		}
+		uint64_t value = at(word + wordShift) >> bitShift;
+		if (bitShift != 0) value |= at(word + wordShift + 1) << (64 - bitShift);
+		return value;
+	}
+
+	bool inLayer(size_t layer, size_t bit) const {
+		const Layer& range = layers[layer];
+		long long word = static_cast<long long>(bit >> 6);
+		if (word < range.first || word >= range.last) return false;
+		return (layerBits[range.offset + (word - range.first)] >> (bit & 63)) & 1;
+	}
+
+	void storeLayer(long long first, long long last) {
+		layers.push_back({ first, last, layerBits.size() });
+		layerBits.insert(layerBits.end(), frontier.begin() + first, frontier.begin() + last);
+	}
+
+	// BFS from the food until it reaches a cell next to the head, then walks the layers back down to the food to get the
+	// whole path. Only safe first moves count, and if the cycle move is the only one there's nothing to search for.
+	// False if the food can't be reached that way
+	bool planPath(SnakeGame::Direction cycleMove) {
+		path.clear();
+		const OccupancyGrid& grid = game.getGrid();
+		const std::vector<uint64_t>& blocked = grid.getWords();
+		const long long words = static_cast<long long>(blocked.size());
+		Cell head = game.head();
+
+		// Head neighbors that can be moved into, checked against every new layer
+		struct Candidate { size_t bit; SnakeGame::Direction direction; };
+		Candidate candidates[4];
+		int candidateCount{ 0 };
+		bool shortcuts{ false };
+		for (int d{ 0 }; d < 4; ++d) {
+			auto direction = static_cast<SnakeGame::Direction>(d);
+			Cell cell = SnakeGame::neighbor(head, direction);
+			if (!grid.inside(cell) || grid.isOccupied(cell) || !isSafeShortcut(cell)) continue;
+			candidates[candidateCount++] = { grid.index(cell), direction };
+			shortcuts |= direction != cycleMove;
+		}
+		if (!shortcuts) return false;
+
+		std::fill(visited.begin(), visited.end(), 0);
+		std::fill(frontier.begin(), frontier.end(), 0);
+		layers.clear();
+		layerBits.clear();
+		size_t foodBit = grid.index(game.getFood());
+		frontier[foodBit >> 6] = visited[foodBit >> 6] = uint64_t{ 1 } << (foodBit & 63);
+		long long first = static_cast<long long>(foodBit >> 6), last = first + 1; // Words the frontier can be in
+		storeLayer(first, last);
+
+		const long long rowWords = width / 64 + 2; // How far one row up or down can reach
+		for (;;) {
+			for (int c{ 0 }; c < candidateCount; ++c) {
+				if ((frontier[candidates[c].bit >> 6] >> (candidates[c].bit & 63)) & 1) {
+					buildPath(candidates[c].bit, candidates[c].direction);
+					return true;
+				}
+			}
+
+			long long nextFirst = std::max(0LL, first - rowWords), nextLast = std::min(words, last + rowWords);
+			bool any{ false };
+			for (long long w{ nextFirst }; w < nextLast; ++w) {
+				uint64_t grown = (shiftedWord(frontier, w, 1) & notFirstColumn[w])
+					| (shiftedWord(frontier, w, -1) & notLastColumn[w])
+					| shiftedWord(frontier, w, width)
+					| shiftedWord(frontier, w, -width);
+				next[w] = grown & ~visited[w] & ~blocked[w];
+				visited[w] |= next[w];
+				any |= next[w] != 0;
+			}
+			if (!any) return false;
+
+			// The new layer replaces the frontier, only the words that were in use need clearing
+			for (long long w{ first }; w < last; ++w) frontier[w] = 0;
+			for (long long w{ nextFirst }; w < nextLast; ++w) {
+				frontier[w] = next[w];
+				next[w] = 0;
+			}
+			while (nextFirst < nextLast && frontier[nextFirst] == 0) ++nextFirst;
+			while (nextLast > nextFirst && frontier[nextLast - 1] == 0) --nextLast;
+			first = nextFirst;
+			last = nextLast;
+			storeLayer(first, last);
+		}
+	}
+
+	// `startBit` is the head neighbor found in the last layer, every step down goes to a neighbor one layer closer to the food
+	void buildPath(size_t startBit, SnakeGame::Direction firstMove) {
+		const OccupancyGrid& grid = game.getGrid();
+		path.push_back(firstMove);
+		Cell cell = grid.cellAt(startBit);
+		for (size_t layer{ layers.size() - 1 }; layer-- > 0;) {
+			for (int d{ 0 }; d < 4; ++d) {
+				auto direction = static_cast<SnakeGame::Direction>(d);
+				Cell step = SnakeGame::neighbor(cell, direction);
+				if (grid.inside(step) && inLayer(layer, grid.index(step))) {
+					path.push_back(direction);
+					cell = step;
+					break;
+				}
+			}
+		}
+		std::reverse(path.begin(), path.end());
+		pathFood = game.getFood();
+		pathStart = game.head();
+	}
+};
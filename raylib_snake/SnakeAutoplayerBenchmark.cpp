@@ -0,0 +1,64 @@
+/*
+	Runs the autoplayer headless on several board sizes and reports ticks/s and how long planning a move takes.
+
+	Every board plays games (until the board is full or the snake dies) for `ticks` ticks in total, so on the big boards the
+	last game is cut short. won/ended counts only the games that ended.
+
+	Usage: SnakeAutoplayerBenchmark [ticks per board = 2000000]
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "SnakeAutoplayer.h"
+#include "SnakeCore.h"
+
+int main(int argc, char* argv[]) {
+	uint64_t ticksPerBoard = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+	std::cout << std::setw(9) << "board" << std::setw(12) << "won/ended" << std::setw(12) << "ticks"
+		<< std::setw(14) << "ticks/s" << std::setw(14) << "plan mean ns" << std::setw(13) << "plan p99 ns" << std::setw(13) << "plan max ns" << "\n";
+
+	for (int size : { 8, 16, 32, 64, 128 }) {
+		uint64_t ticks{ 0 };
+		int games{ 0 }, ended{ 0 }, won{ 0 };
+		std::vector<float> planNanoseconds;
+		planNanoseconds.reserve(ticksPerBoard);
+		double totalSeconds{ 0 };
+
+		while (ticks < ticksPerBoard) {
+			SnakeGame game{ size, size, static_cast<uint64_t>(games) + 1 };
+			SnakeAutoplayer autoplayer{ game };
+			++games;
+
+			auto gameStart = std::chrono::steady_clock::now();
+			while (game.getState() == SnakeGame::State::PLAYING && ticks < ticksPerBoard) {
+				auto planStart = std::chrono::steady_clock::now();
+				SnakeGame::Direction move = autoplayer.nextMove();
+				planNanoseconds.push_back(std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - planStart).count());
+
+				game.setDirection(move);
+				game.tick();
+				++ticks;
+			}
+			totalSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - gameStart).count();
+			if (game.getState() != SnakeGame::State::PLAYING) ++ended;
+			if (game.getState() == SnakeGame::State::WON) ++won;
+		}
+
+		double mean{ 0 };
+		for (float ns : planNanoseconds) mean += ns;
+		mean /= planNanoseconds.size();
+		std::sort(planNanoseconds.begin(), planNanoseconds.end());
+
+		std::cout << std::setw(9) << (std::to_string(size) + "x" + std::to_string(size)) << std::setw(12) << (std::to_string(won) + "/" + std::to_string(ended))
+			<< std::setw(12) << ticks << std::setw(14) << std::fixed << std::setprecision(0) << ticks / totalSeconds
+			<< std::setw(14) << mean << std::setw(13) << planNanoseconds[planNanoseconds.size() * 99 / 100]
+			<< std::setw(13) << planNanoseconds.back() << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,77 @@
+/*
+	Per tick cost of SnakeGame for growing boards and snake lengths, the point is that it stays flat all the way to a
+	4096x4096 board with a snake covering almost all of it.
+
+	The snake follows a Hamiltonian cycle of the board, so it never dies no matter how long it is. To get a long snake
+	it is told to grow (untimed) and then the ticks are timed. Food placement (the select on the occupancy grid) is also
+	timed on its own, on a board with 99% of the cells taken at random.
+
+	Usage: SnakeBenchmark [ticks = 1000000]
+*/
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include "SnakeAutoplayer.h"
+#include "SnakeCore.h"
+
+double nanosecondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+	uint64_t timedTicks = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+	std::cout << std::setw(10) << "board" << std::setw(14) << "snake length" << std::setw(10) << "fill"
+		<< std::setw(12) << "ns/tick" << "\n";
+
+	for (int size : { 64, 256, 1024, 4096 }) {
+		for (double fill : { 0.01, 0.5, 0.99 }) {
+			SnakeGame game{ size, size, 42 };
+			size_t targetLength = static_cast<size_t>(fill * size * size);
+			game.grow(static_cast<int>(targetLength - game.length()));
+
+			// Untimed: grow the snake to the target length
+			while (game.length() < targetLength && game.getState() == SnakeGame::State::PLAYING) {
+				game.setDirection(hamiltonianCycleDirection(game.head(), size, size));
+				game.tick();
+			}
+
+			uint64_t ticks{ 0 };
+			auto start = std::chrono::steady_clock::now();
+			while (ticks < timedTicks && game.getState() == SnakeGame::State::PLAYING) {
+				game.setDirection(hamiltonianCycleDirection(game.head(), size, size));
+				game.tick();
+				++ticks;
+			}
+			double tickNanoseconds = nanosecondsSince(start) / ticks;
+			const char* note = (game.getState() == SnakeGame::State::WON) ? " (board filled up, stopped early)" : "";
+
+			std::cout << std::setw(10) << (std::to_string(size) + "x" + std::to_string(size)) << std::setw(14) << game.length()
+				<< std::setw(9) << static_cast<int>(fill * 100) << "%" << std::setw(12) << std::fixed << std::setprecision(2) << tickNanoseconds
+				<< note << "\n";
+		}
+
+		// Food placement on its own: the k-th free cell of a board 99% full
+		OccupancyGrid grid{ size, size };
+		std::mt19937_64 rng{ 7 };
+		std::uniform_int_distribution<int> coordinate{ 0, size - 1 };
+		while (grid.occupiedCount() < grid.cellCount() * 99 / 100) {
+			Cell cell{ coordinate(rng), coordinate(rng) };
+			if (!grid.isOccupied(cell)) grid.occupy(cell);
+		}
+
+		std::uniform_int_distribution<size_t> pick{ 0, grid.freeCount() - 1 };
+		const int spawns{ 100000 };
+		volatile int sink{ 0 };
+		auto start = std::chrono::steady_clock::now();
+		for (int i{ 0 }; i < spawns; ++i)
+			sink = sink + grid.selectFree(pick(rng)).x;
+		std::cout << std::setw(10) << (std::to_string(size) + "x" + std::to_string(size)) << "  food spawn on a 99% full board: "
+			<< nanosecondsSince(start) / spawns << " ns\n";
+	}
+
+	return 0;
+}
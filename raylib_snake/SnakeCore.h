@@ -0,0 +1,307 @@
+/*
+	Snake game logic, no raylib in here so it can run headless.
+
+	The body is a fixed capacity ring buffer of cell indices (capacity = board size, the snake can't be longer than the board),
+	so moving is a head push and a tail pop with no allocation. The board is a bitset with one bit per cell, set where the snake
+	is, which makes the self collision test a single bit read.
+
+	Food goes on a uniformly random free cell without retrying: pick k in [0, freeCells) and find the k-th zero bit (select).
+	To do that fast the board keeps a Fenwick tree with the number of occupied cells per block of 512 bits, so select is a
+	descent over the tree (log of the number of blocks) plus a popcount scan of at most 8 words.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+inline int popcount64(uint64_t word) {
+#if defined(_MSC_VER)
+	return static_cast<int>(__popcnt64(word));
+#else
+	return __builtin_popcountll(word);
+#endif
+}
+
+inline int countTrailingZeros64(uint64_t word) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+// Position of the k-th (0 based) set bit of `word`, k has to be lower than popcount64(word)
+inline int selectInWord(uint64_t word, int k) {
+	for (int i{ 0 }; i < k; ++i)
+		word &= word - 1; // Drop the lowest set bit
+	return countTrailingZeros64(word);
+}
+
+struct Cell {
+	int x, y;
+
+	bool operator==(const Cell& other) const { return x == other.x && y == other.y; }
+	bool operator!=(const Cell& other) const { return !(*this == other); }
+};
+
+template <typename T> class RingBuffer {
+private:
+	std::vector<T> items;
+	size_t first{ 0 }; // Index of the oldest item
+	size_t count{ 0 };
+
+public:
+	explicit RingBuffer(size_t capacity)
+		: items(capacity) {}
+
+	size_t size() const { return count; }
+	size_t capacity() const { return items.size(); }
+	bool full() const { return count == items.size(); }
+
+	// Newest item is the back, oldest the front
+	void pushBack(const T& item) {
+		if (full()) throw std::length_error("RingBuffer is full");
+		items[wrap(first + count)] = item;
+		++count;
+	}
+
+	void popFront() {
+		first = wrap(first + 1);
+		--count;
+	}
+
+	const T& front() const { return items[first]; }
+	const T& back() const { return items[wrap(first + count - 1)]; }
+	const T& operator[](size_t i) const { return items[wrap(first + i)]; } // 0 is the front
+
+	void clear() {
+		first = 0;
+		count = 0;
+	}
+
+private:
+	size_t wrap(size_t index) const {
+		return index >= items.size() ? index - items.size() : index;
+	}
+};
+
+class OccupancyGrid {
+public:
+	static constexpr int wordsPerBlock{ 8 }; // 512 cells per Fenwick tree leaf
+
+	OccupancyGrid(int width, int height)
+		: width{ width }, height{ height },
+		  words((static_cast<size_t>(width) * height + 64 * wordsPerBlock - 1) / (64 * wordsPerBlock) * wordsPerBlock, 0),
+		  tree(words.size() / wordsPerBlock + 1, 0) {
+		clear();
+	}
+
+	int getWidth() const { return width; }
+	int getHeight() const { return height; }
+	size_t cellCount() const { return static_cast<size_t>(width) * height; }
+	size_t occupiedCount() const { return occupied; }
+	size_t freeCount() const { return cellCount() - occupied; }
+
+	size_t index(Cell cell) const { return static_cast<size_t>(cell.y) * width + cell.x; }
+	Cell cellAt(size_t index) const { return { static_cast<int>(index % width), static_cast<int>(index / width) }; }
+	bool inside(Cell cell) const { return cell.x >= 0 && cell.y >= 0 && cell.x < width && cell.y < height; }
+
+	bool isOccupied(size_t bit) const { return (words[bit >> 6] >> (bit & 63)) & 1; }
+	bool isOccupied(Cell cell) const { return isOccupied(index(cell)); }
+
+	void occupy(size_t bit) {
+		set(bit);
+		++occupied;
+	}
+	void occupy(Cell cell) { occupy(index(cell)); }
+
+	void release(size_t bit) {
+		words[bit >> 6] &= ~(uint64_t{ 1 } << (bit & 63));
+		addToTree(bit / (64 * wordsPerBlock), -1);
+		--occupied;
+	}
+	void release(Cell cell) { release(index(cell)); }
+
+	void clear() {
+		std::fill(words.begin(), words.end(), 0);
+		std::fill(tree.begin(), tree.end(), 0);
+
+		// Bits past the last cell (the words are padded to whole blocks) are marked occupied so they are never picked as free
+		for (size_t bit{ cellCount() }; bit < words.size() * 64; ++bit)
+			set(bit);
+		occupied = 0;
+	}
+
+	// The k-th free cell in row major order (k < freeCount())
+	Cell selectFree(size_t k) const {
+		// Fenwick descent over free cells per block: find the block that holds the k-th free cell
+		const size_t cellsPerBlock = 64 * wordsPerBlock;
+		size_t blocks = tree.size() - 1;
+		size_t block{ 0 };
+		size_t step{ 1 };
+		while (step * 2 <= blocks) step *= 2;
+		for (; step > 0; step /= 2) {
+			size_t next = block + step;
+			if (next <= blocks) {
+				size_t freeInRange = step * cellsPerBlock - tree[next];
+				if (freeInRange <= k) {
+					block = next;
+					k -= freeInRange;
+				}
+			}
+		}
+
+		// Then the word inside the block, and the bit inside the word
+		for (size_t word{ block * wordsPerBlock }; word < words.size(); ++word) {
+			uint64_t freeBits = ~words[word];
+			size_t freeInWord = static_cast<size_t>(popcount64(freeBits));
+			if (k < freeInWord)
+				return cellAt(word * 64 + selectInWord(freeBits, static_cast<int>(k)));
+			k -= freeInWord;
+		}
+		throw std::out_of_range("OccupancyGrid::selectFree: not that many free cells");
+	}
+
+	const std::vector<uint64_t>& getWords() const { return words; }
+
+private:
+	int width, height;
+	std::vector<uint64_t> words; // Bit i is cell i in row major order, 1 = occupied
+	std::vector<uint32_t> tree; // 1 based Fenwick tree, occupied cells per block
+	size_t occupied{ 0 };
+
+	void set(size_t bit) {
+		words[bit >> 6] |= uint64_t{ 1 } << (bit & 63);
+		addToTree(bit / (64 * wordsPerBlock), 1);
+	}
+
+	void addToTree(size_t block, int delta) {
+		for (size_t i{ block + 1 }; i < tree.size(); i += i & (~i + 1))
+			tree[i] += delta;
+	}
+};
+
+class SnakeGame {
+public:
+	enum Direction { UP = 0, RIGHT, DOWN, LEFT };
+	enum class State { PLAYING, DEAD, WON };
+
+	SnakeGame(int width, int height, uint64_t seed = std::random_device{}())
+		: grid{ width, height }, body{ static_cast<size_t>(width) * height }, rng{ seed } {
+		reset();
+	}
+
+	void reset() {
+		grid.clear();
+		body.clear();
+		direction = RIGHT;
+		movedDirection = RIGHT;
+		pendingGrowth = 2; // Starts as 1 cell and grows to 3 in the first moves
+		state = State::PLAYING;
+		ticks = 0;
+
+		size_t start = grid.index({ grid.getWidth() / 2, grid.getHeight() / 2 });
+		body.pushBack(static_cast<uint32_t>(start));
+		grid.occupy(start);
+		headCell = grid.cellAt(start);
+		spawnFood();
+	}
+
+	// Ignored if it would turn the snake onto itself. Checked against the last move made, not the last direction set: two
+	// turns before a tick (UP then LEFT while moving RIGHT) would otherwise end up reversing into the neck
+	void setDirection(Direction newDirection) {
+		if (body.size() > 1 && (newDirection + 2) % 4 == movedDirection) return;
+		direction = newDirection;
+	}
+
+	// Moves one cell. Constant time unless food was eaten (then food placement is a select, see OccupancyGrid)
+	State tick() {
+		if (state != State::PLAYING) return state;
+		++ticks;
+
+		Cell next = neighbor(head(), direction);
+		if (!grid.inside(next)) return state = State::DEAD;
+
+		bool eats = (next == food);
+		int growth = pendingGrowth + (eats ? growthPerFood : 0);
+
+		// The tail moves out of the way in the same tick (unless the snake is growing), so moving into it is fine. Checked
+		// before changing anything, a dead snake stays exactly where it died
+		size_t nextIndex = grid.index(next);
+		bool tailMoves = (growth == 0);
+		if (grid.isOccupied(nextIndex) && !(tailMoves && nextIndex == body.front())) return state = State::DEAD;
+
+		pendingGrowth = growth;
+		if (pendingGrowth > 0) --pendingGrowth;
+		else {
+			grid.release(body.front());
+			body.popFront();
+		}
+
+		grid.occupy(nextIndex);
+		body.pushBack(static_cast<uint32_t>(nextIndex));
+		headCell = next;
+		movedDirection = direction;
+
+		if (eats && !spawnFood()) state = State::WON;
+		return state;
+	}
+
+	// Extra cells the snake will grow, one per tick, on top of what food gives
+	void grow(int cells) { pendingGrowth += cells; }
+
+	static Cell neighbor(Cell cell, Direction direction) {
+		switch (direction) {
+		case UP: return { cell.x, cell.y - 1 };
+		case DOWN: return { cell.x, cell.y + 1 };
+		case LEFT: return { cell.x - 1, cell.y };
+		case RIGHT:
+		default: return { cell.x + 1, cell.y };
+		}
+	}
+
+	Cell head() const { return headCell; }
+	Cell tail() const { return grid.cellAt(body.front()); }
+	Cell getFood() const { return food; }
+	Direction getDirection() const { return direction; }
+	State getState() const { return state; }
+	size_t length() const { return body.size(); }
+	uint64_t getTicks() const { return ticks; }
+	int getPendingGrowth() const { return pendingGrowth; }
+	const OccupancyGrid& getGrid() const { return grid; }
+	const RingBuffer<uint32_t>& getBody() const { return body; } // Cell indices, see OccupancyGrid::cellAt
+
+	static constexpr int growthPerFood{ 1 };
+
+private:
+	OccupancyGrid grid;
+	RingBuffer<uint32_t> body; // front = tail, back = head
+	Cell headCell{ 0, 0 }; // Kept as a cell too, so moving doesn't need a division
+	std::mt19937_64 rng;
+	Cell food{ -1, -1 };
+	Direction direction{ RIGHT }; // Next move
+	Direction movedDirection{ RIGHT }; // Last move made
+	int pendingGrowth{ 0 };
+	State state{ State::PLAYING };
+	uint64_t ticks{ 0 };
+
+	// False if the board is full
+	bool spawnFood() {
+		if (grid.freeCount() == 0) {
+			food = { -1, -1 };
+			return false;
+		}
+		std::uniform_int_distribution<size_t> pick{ 0, grid.freeCount() - 1 };
+		food = grid.selectFree(pick(rng));
+		return true;
+	}
+};
@@ -0,0 +1,96 @@
+/*
+	Turning and dying rules of SnakeGame, run by ctest. Returns non zero if any check fails.
+*/
+#include <iostream>
+
+#include "SnakeCore.h"
+
+int failures{ 0 };
+
+void check(bool condition, const char* what) {
+	if (!condition) {
+		std::cerr << "FAILED: " << what << "\n";
+		++failures;
+	}
+}
+
+// A 3 cell snake moving right in the middle of the board
+SnakeGame movingRight() {
+	SnakeGame game{ 20, 20, 1 };
+	game.tick();
+	game.tick();
+	return game;
+}
+
+int main() {
+	{
+		SnakeGame game = movingRight();
+		Cell head = game.head();
+		game.setDirection(SnakeGame::LEFT);
+		game.tick();
+		check(game.getState() == SnakeGame::State::PLAYING, "reversing is ignored");
+		check(game.head() == Cell{ head.x + 1, head.y }, "reversing keeps going the same way");
+	}
+
+	{
+		// Two presses before the same tick: LEFT is checked against the last move (RIGHT), so it's ignored and UP stays
+		SnakeGame game = movingRight();
+		Cell head = game.head();
+		game.setDirection(SnakeGame::UP);
+		game.setDirection(SnakeGame::LEFT);
+		game.tick();
+		check(game.getState() == SnakeGame::State::PLAYING, "UP then LEFT in one tick while moving right doesn't kill the snake");
+		check(game.head() == Cell{ head.x, head.y - 1 }, "UP then LEFT in one tick moves up");
+	}
+
+	{
+		// Same presses on different ticks are a normal U-turn
+		SnakeGame game = movingRight();
+		Cell head = game.head();
+		game.setDirection(SnakeGame::UP);
+		game.tick();
+		game.setDirection(SnakeGame::LEFT);
+		game.tick();
+		check(game.getState() == SnakeGame::State::PLAYING, "UP then LEFT on different ticks is allowed");
+		check(game.head() == Cell{ head.x - 1, head.y - 1 }, "UP then LEFT on different ticks turns twice");
+	}
+
+	{
+		// 6 cells, turning up, left and down bites the body: it dies with the body where it was
+		SnakeGame game = movingRight();
+		game.grow(3);
+		for (int i{ 0 }; i < 3; ++i) game.tick();
+		game.setDirection(SnakeGame::UP);
+		game.tick();
+		game.setDirection(SnakeGame::LEFT);
+		game.tick();
+		size_t length = game.length();
+		Cell head = game.head(), tail = game.tail();
+		game.setDirection(SnakeGame::DOWN);
+		game.tick();
+		const OccupancyGrid& grid = game.getGrid();
+		check(game.getState() == SnakeGame::State::DEAD, "running into the body kills the snake");
+		check(game.length() == length, "dying doesn't shorten the snake");
+		check(game.head() == head && game.tail() == tail, "dying doesn't move the snake");
+		check(grid.getWidth() * grid.getHeight() - grid.freeCount() == length, "the grid still has every cell of the dead snake");
+	}
+
+	{
+		// 4 cells, same turns: the cell below is the tail, which moves away in the same tick
+		SnakeGame game = movingRight();
+		game.grow(1);
+		game.tick();
+		Cell head = game.head();
+		game.setDirection(SnakeGame::UP);
+		game.tick();
+		game.setDirection(SnakeGame::LEFT);
+		game.tick();
+		game.setDirection(SnakeGame::DOWN);
+		game.tick();
+		check(game.getState() == SnakeGame::State::PLAYING, "moving into the tail is allowed");
+		check(game.head() == Cell{ head.x - 1, head.y }, "moving into the tail takes its cell");
+	}
+
+	if (failures == 0) std::cout << "All snake rule checks passed\n";
+	return failures == 0 ? 0 : 1;
+}